@@ -0,0 +1,627 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * ili9481-bus.c — ILI9481 8080-parallel GPIO bus (16-bit or 8-bit)
+ *
+ * Bit-bang transport shared by the fbdev (ili9481-gpio) and DRM
+ * (ili9481-drm) drivers: GPIO acquisition, the BCM2835 direct-register
+ * fast path, the panel init sequence and windowed pixel writes.
+ *
+ * The bus width follows the number of data-gpios: 16 lines carry one
+ * pixel per /WR strobe; 8 lines (the 26-pin shields the userspace
+ * gpio_mmio daemon drives) carry each RGB565 pixel as two strobes, high
+ * byte first.  Commands and parameters are one strobe either way.
+ *
+ * With the DT "low-colour" flag an 8-bit bus runs the panel in 3 bpp
+ * (COLMOD 0x11) and idle mode: the framebuffer stays RGB565, each pixel
+ * is cut to the top bit of R, G and B, and two pixels go out per strobe
+ * on DB5–DB0 — a quarter of the strobes of 16 bpp.  The flag is refused
+ * on a 16-bit bus, where that packing is not the 3 bpp transfer format.
+ *
+ * Copyright 2025  ILI9481-driver contributors
+ */
+
+#include <linux/module.h>
+#include <linux/kernel.h>
+#include <linux/device.h>
+#include <linux/of.h>
+#include <linux/of_address.h>
+#include <linux/io.h>
+#include <dt-bindings/gpio/gpio.h>
+#include <linux/gpio/consumer.h>
+#include <linux/delay.h>
+#include <linux/ktime.h>
+#include <linux/math64.h>
+#include <linux/sched.h>
+#include <linux/slab.h>
+
+#include "ili9481-gpio.h"
+#include "ili9481-bus.h"
+
+#define DRIVER_DESC	"ILI9481 parallel GPIO bus"
+
+static bool fast_io = true;
+module_param(fast_io, bool, 0444);
+MODULE_PARM_DESC(fast_io,
+		 "Drive the bus through the BCM2835 GPIO registers when possible (default: true)");
+
+static bool calibrate;
+module_param(calibrate, bool, 0444);
+MODULE_PARM_DESC(calibrate,
+		 "Measure and log bus throughput at probe time (default: false)");
+
+/*
+ * /WR hold times.  Without DT properties both paths keep the datasheet
+ * tWRL of 15 ns; a board that has measured its strobe can drop it with
+ * "wr-low-ns = <0>".
+ */
+#define ILI9481_WR_LOW_NS_DEFAULT	15
+#define ILI9481_WR_NS_MAX	1000
+
+/* Calibration: pixels per pass and passes (best one is reported) */
+#define ILI9481_CAL_PIXELS	4096
+#define ILI9481_CAL_PASSES	3
+
+/* BCM2835/BCM2711 GPIO block: set/clear registers for bank 0 */
+#define BCM2835_GPSET0		0x1C
+#define BCM2835_GPCLR0		0x28
+
+/* ================================================================== */
+/* GPIO bit-bang write helpers                                        */
+/* ================================================================== */
+
+/* Busy-wait for a strobe hold time; free when the time is zero. */
+static inline void ili9481_hold(u32 ns)
+{
+	if (ns)
+		ndelay(ns);
+}
+
+/*
+ * Write a raw 16-bit value onto DB0–DB15 and pulse /WR.  On an 8-bit bus
+ * only the low byte reaches DB0–DB7 (the high-byte tables are empty and
+ * gpiod only drives 8 lines), which is what commands and parameters need.
+ *
+ * 8080-style timing (active-low WR in DTS):
+ *   1.  Place data on bus
+ *   2.  Assert /WR  (gpiod logical 1 → pin LOW)
+ *   3.  Hold wr_low_ns  (ILI9481 tWRL ≥ 15 ns)
+ *   4.  De-assert /WR (gpiod logical 0 → pin HIGH, rising edge latches data)
+ *   5.  Hold wr_high_ns (ILI9481 tWRH)
+ */
+static inline void ili9481_write16(struct ili9481_bus *bus, u16 val)
+{
+	DECLARE_BITMAP(bits, 16);
+
+	/*
+	 * Fast path: data 1-bits; data 0-bits together with /WR low; /WR
+	 * high.  Stores to one peripheral complete in program order.
+	 */
+	if (likely(bus->gpio_set)) {
+		u8 lo = val & 0xFF, hi = val >> 8;
+
+		writel_relaxed(bus->lut_set[0][lo] | bus->lut_set[1][hi],
+			       bus->gpio_set);
+		writel_relaxed(bus->lut_clr[0][lo] | bus->lut_clr[1][hi] |
+			       bus->wr_mask, bus->gpio_clr);
+		ili9481_hold(bus->wr_low_ns);
+		writel_relaxed(bus->wr_mask, bus->gpio_set);
+		ili9481_hold(bus->wr_high_ns);
+		return;
+	}
+
+	bits[0] = val;
+
+	gpiod_set_array_value(bus->data_gpios->ndescs,
+			      bus->data_gpios->desc,
+			      bus->data_gpios->info,
+			      bits);
+
+	gpiod_set_value(bus->wr_gpio, 1);	/* /WR LOW  (assert)   */
+	ili9481_hold(bus->wr_low_ns);
+	gpiod_set_value(bus->wr_gpio, 0);	/* /WR HIGH (latch)    */
+	ili9481_hold(bus->wr_high_ns);
+}
+
+/* Pulse /WR with the data lines unchanged. */
+static inline void ili9481_strobe(struct ili9481_bus *bus)
+{
+	if (likely(bus->gpio_set)) {
+		writel_relaxed(bus->wr_mask, bus->gpio_clr);
+		ili9481_hold(bus->wr_low_ns);
+		writel_relaxed(bus->wr_mask, bus->gpio_set);
+	} else {
+		gpiod_set_value(bus->wr_gpio, 1);	/* /WR LOW  (assert)   */
+		ili9481_hold(bus->wr_low_ns);
+		gpiod_set_value(bus->wr_gpio, 0);	/* /WR HIGH (latch)    */
+	}
+	ili9481_hold(bus->wr_high_ns);
+}
+
+/*
+ * 8-bit bus: write one byte, tracking the byte left on DB0–DB7 in @cur
+ * so that an unchanged byte costs a bare strobe.
+ */
+static inline void ili9481_write8(struct ili9481_bus *bus, u8 b, u32 *cur)
+{
+	if (b == *cur) {
+		ili9481_strobe(bus);
+		return;
+	}
+	ili9481_write16(bus, b);
+	*cur = b;
+}
+
+/*
+ * 8-bit counterpart of ili9481_write_span(): each pixel is a byte pair,
+ * high byte first.  The data lines are only driven when the byte on the
+ * bus changes, so runs of black, white and grey (hi == lo) and repeated
+ * pixels whose bytes match their neighbours go out as bare strobes.
+ */
+static void ili9481_write_span8(struct ili9481_bus *bus, const u16 *px, u32 n)
+{
+	u32 cur = U32_MAX;	/* no byte matches: first one is driven */
+	u32 i;
+
+	for (i = 0; i < n; i++) {
+		ili9481_write8(bus, px[i] >> 8, &cur);
+		ili9481_write8(bus, px[i] & 0xFF, &cur);
+	}
+}
+
+/* RGB565 → 3-bit R G B (the MSB of each channel), in panel bit order. */
+static inline u8 ili9481_rgb111(u16 v)
+{
+	return ((v >> 13) & 4) | ((v >> 9) & 2) | ((v >> 4) & 1);
+}
+
+/*
+ * Low-colour counterpart of ili9481_write_span(): pixel pairs packed as
+ * (first << 3) | second, one strobe per pair.  @n must be even (see
+ * ili9481_bus_align()).  Text on a flat background is mostly repeated
+ * bytes, which cost a bare strobe.
+ */
+static void ili9481_write_span3(struct ili9481_bus *bus, const u16 *px, u32 n)
+{
+	u32 cur = U32_MAX;	/* no byte matches: first one is driven */
+	u32 i;
+
+	for (i = 0; i + 1 < n; i += 2)
+		ili9481_write8(bus, ili9481_rgb111(px[i]) << 3 |
+				    ili9481_rgb111(px[i + 1]), &cur);
+}
+
+/*
+ * Write @n pixels from @px in one call.  The data lines are only updated
+ * when a pixel differs from the one before it; a run of equal pixels
+ * (fills, flat UI backgrounds) costs one /WR pulse per pixel.  On the
+ * gpiod path that skips the gpiod_set_array_value() call entirely; when
+ * it is needed it goes through the array's cached gpio_array info, i.e.
+ * straight to the chip's set_multiple.
+ */
+static void ili9481_write_span(struct ili9481_bus *bus, const u16 *px, u32 n)
+{
+	struct gpio_descs *d = bus->data_gpios;
+	DECLARE_BITMAP(bits, 16);
+	u32 prev = U32_MAX;	/* no pixel value matches: first one is driven */
+	u32 i;
+
+	if (bus->low_colour) {
+		ili9481_write_span3(bus, px, n);
+		return;
+	}
+	if (bus->width == 8) {
+		ili9481_write_span8(bus, px, n);
+		return;
+	}
+
+	if (likely(bus->gpio_set)) {
+		for (i = 0; i < n; i++) {
+			u16 val = px[i];
+
+			if (val != prev) {
+				ili9481_write16(bus, val);
+				prev = val;
+				continue;
+			}
+			ili9481_strobe(bus);
+		}
+		return;
+	}
+
+	for (i = 0; i < n; i++) {
+		if (px[i] != prev) {
+			bits[0] = px[i];
+			gpiod_set_array_value(d->ndescs, d->desc, d->info, bits);
+			prev = px[i];
+		}
+		ili9481_strobe(bus);
+	}
+}
+
+/* Send a command byte (DC low, 8-bit zero-extended to 16 bits). */
+void ili9481_bus_write_cmd(struct ili9481_bus *bus, u8 cmd)
+{
+	gpiod_set_value(bus->dc_gpio, 0);	/* command mode */
+	ili9481_write16(bus, cmd);
+	gpiod_set_value(bus->dc_gpio, 1);	/* back to data mode */
+}
+EXPORT_SYMBOL_GPL(ili9481_bus_write_cmd);
+
+/* Send an 8-bit data/parameter byte (DC high). */
+void ili9481_bus_write_data(struct ili9481_bus *bus, u8 data)
+{
+	ili9481_write16(bus, data);
+}
+EXPORT_SYMBOL_GPL(ili9481_bus_write_data);
+
+/* ================================================================== */
+/* BCM2835 direct-register fast path                                  */
+/* ================================================================== */
+
+static const struct of_device_id ili9481_fast_gpio_match[] = {
+	{ .compatible = "brcm,bcm2835-gpio" },
+	{ .compatible = "brcm,bcm2711-gpio" },
+	{ .compatible = "brcm,bcm7211-gpio" },
+	{ /* sentinel */ }
+};
+
+/*
+ * Resolve entry @index of the @prop GPIO list to a pin on a supported
+ * GPIO block.  Returns the pin number, or -errno if the line is on
+ * another controller than @ctrl (set on first use) or is an active-low
+ * line where @inverted_ok is false.
+ */
+static int ili9481_fast_pin(struct device_node *np, const char *prop,
+			    int index, bool inverted_ok,
+			    struct device_node **ctrl)
+{
+	struct of_phandle_args args;
+	int ret;
+
+	ret = of_parse_phandle_with_args(np, prop, "#gpio-cells", index, &args);
+	if (ret)
+		return ret;
+
+	if (!*ctrl) {
+		if (!of_match_node(ili9481_fast_gpio_match, args.np))
+			ret = -ENODEV;
+		else
+			*ctrl = of_node_get(args.np);
+	} else if (args.np != *ctrl) {
+		ret = -EXDEV;
+	}
+	if (!ret && args.args_count < 1)
+		ret = -EINVAL;
+	if (!ret && !inverted_ok && args.args_count > 1 &&
+	    (args.args[1] & GPIO_ACTIVE_LOW))
+		ret = -EINVAL;
+
+	of_node_put(args.np);
+	return ret ? ret : args.args[0];
+}
+
+static void ili9481_fast_unmap(void *base)
+{
+	iounmap(base);
+}
+
+/*
+ * Map the GPIO block directly if /WR and all data lines sit in one
+ * 32-pin bank of a BCM2835-family controller; otherwise keep gpiod.
+ * The pins stay claimed (and muxed as outputs) through gpiod, and the
+ * set/clear registers are write-1-only, so DC/RST toggled via gpiod on
+ * the same bank cannot race with this path.
+ */
+static void ili9481_setup_fast_io(struct ili9481_bus *bus)
+{
+	struct device_node *np = bus->dev->of_node;
+	struct device_node *ctrl = NULL;
+	void __iomem *base;
+	int pins[16], wr, bank, i, v;
+	int ret;
+
+	if (!fast_io)
+		return;
+
+	/* /WR is always a physical active-low strobe; its DT flag is moot */
+	ret = wr = ili9481_fast_pin(np, "wr-gpios", 0, true, &ctrl);
+	for (i = 0; i < bus->width && ret >= 0; i++) {
+		ret = pins[i] = ili9481_fast_pin(np, "data-gpios", i, false, &ctrl);
+		if (ret >= 0 && pins[i] / 32 != wr / 32)
+			ret = -EXDEV;
+	}
+	if (ret < 0) {
+		dev_info(bus->dev, "fast I/O unavailable (%d), using gpiod\n", ret);
+		goto out;
+	}
+
+	base = of_iomap(ctrl, 0);
+	if (!base || devm_add_action_or_reset(bus->dev, ili9481_fast_unmap, base)) {
+		dev_warn(bus->dev, "cannot map GPIO registers, using gpiod\n");
+		goto out;
+	}
+
+	bank = wr / 32;
+	for (v = 0; v < 256; v++) {
+		for (i = 0; i < 8; i++) {
+			u32 lo = BIT(pins[i] % 32);
+			u32 hi = bus->width == 16 ? BIT(pins[i + 8] % 32) : 0;
+
+			if (v & BIT(i)) {
+				bus->lut_set[0][v] |= lo;
+				bus->lut_set[1][v] |= hi;
+			} else {
+				bus->lut_clr[0][v] |= lo;
+				bus->lut_clr[1][v] |= hi;
+			}
+		}
+	}
+	bus->wr_mask  = BIT(wr % 32);
+	bus->gpio_set = base + BCM2835_GPSET0 + 4 * bank;
+	bus->gpio_clr = base + BCM2835_GPCLR0 + 4 * bank;
+
+	dev_info(bus->dev,
+		 "fast I/O: direct GPIO register writes (bank %d, %u-bit)\n",
+		 bank, bus->width);
+out:
+	of_node_put(ctrl);
+}
+
+/* ================================================================== */
+/* Strobe timing and calibration                                      */
+/* ================================================================== */
+
+/*
+ * Read "wr-low-ns" / "wr-high-ns" (minimum /WR low and high times added
+ * per write).  Boards whose level shifters are slow need more; values
+ * above ILI9481_WR_NS_MAX are clamped since they only waste bus time.
+ * wr-low-ns defaults to tWRL on both paths: a direct-register store can
+ * be shorter than that on BCM2711, so 0 is only used when the DT asks.
+ */
+static void ili9481_setup_timing(struct ili9481_bus *bus)
+{
+	struct device_node *np = bus->dev->of_node;
+
+	if (of_property_read_u32(np, "wr-low-ns", &bus->wr_low_ns))
+		bus->wr_low_ns = ILI9481_WR_LOW_NS_DEFAULT;
+	if (of_property_read_u32(np, "wr-high-ns", &bus->wr_high_ns))
+		bus->wr_high_ns = 0;
+
+	if (bus->wr_low_ns > ILI9481_WR_NS_MAX ||
+	    bus->wr_high_ns > ILI9481_WR_NS_MAX) {
+		dev_warn(bus->dev, "wr-low/high-ns clamped to %u ns\n",
+			 ILI9481_WR_NS_MAX);
+		bus->wr_low_ns = min_t(u32, bus->wr_low_ns, ILI9481_WR_NS_MAX);
+		bus->wr_high_ns = min_t(u32, bus->wr_high_ns, ILI9481_WR_NS_MAX);
+	}
+}
+
+/* Time one span of @n pixels; best of ILI9481_CAL_PASSES, in ns. */
+static u64 ili9481_time_span(struct ili9481_bus *bus, const u16 *px, u32 n)
+{
+	u64 best = U64_MAX;
+	int pass;
+
+	for (pass = 0; pass < ILI9481_CAL_PASSES; pass++) {
+		u64 t0 = ktime_get_ns();
+
+		ili9481_write_span(bus, px, n);
+		best = min(best, ktime_get_ns() - t0);
+		cond_resched();
+	}
+	return max_t(u64, best, 1);
+}
+
+/*
+ * calibrate=1: measure what the bus actually achieves with the chosen
+ * path and hold times, for both changing pixels (data lines + strobe)
+ * and a repeated pixel (strobe only), and log it with the resulting
+ * full-frame time.  Runs before the panel is initialised, in data mode
+ * and with the panel held in reset when /RST is wired, so the test
+ * pattern is neither executed as commands nor displayed.
+ */
+static void ili9481_calibrate(struct ili9481_bus *bus)
+{
+	u64 ns_diff, ns_same, frame_us;
+	u16 *px;
+	u32 i;
+
+	px = kmalloc_array(ILI9481_CAL_PIXELS, sizeof(*px), GFP_KERNEL);
+	if (!px)
+		return;
+
+	gpiod_set_value(bus->dc_gpio, 1);
+	if (bus->rst_gpio)
+		gpiod_set_value(bus->rst_gpio, 1);
+
+	/* Alternate every data line on every write: the worst case */
+	for (i = 0; i < ILI9481_CAL_PIXELS; i++)
+		px[i] = (i & 1) ? 0xAAAA : 0x5555;
+	ns_diff = ili9481_time_span(bus, px, ILI9481_CAL_PIXELS);
+
+	memset(px, 0, ILI9481_CAL_PIXELS * sizeof(*px));
+	ns_same = ili9481_time_span(bus, px, ILI9481_CAL_PIXELS);
+
+	kfree(px);
+	if (bus->rst_gpio)
+		gpiod_set_value(bus->rst_gpio, 0);
+
+	frame_us = div_u64(ns_diff * ILI9481_WIDTH * ILI9481_HEIGHT,
+			   ILI9481_CAL_PIXELS * 1000);
+	dev_info(bus->dev,
+		 "calibration (%s, wr-low %u ns, wr-high %u ns): %llu kpx/s changing, %llu kpx/s repeated, full frame %llu us\n",
+		 bus->gpio_set ? "fast I/O" : "gpiod",
+		 bus->wr_low_ns, bus->wr_high_ns,
+		 div64_u64((u64)ILI9481_CAL_PIXELS * NSEC_PER_MSEC, ns_diff),
+		 div64_u64((u64)ILI9481_CAL_PIXELS * NSEC_PER_MSEC, ns_same),
+		 frame_us);
+}
+
+/* ================================================================== */
+/* GPIO acquisition                                                   */
+/* ================================================================== */
+
+int ili9481_bus_init(struct ili9481_bus *bus, struct device *dev)
+{
+	int ret;
+
+	memset(bus, 0, sizeof(*bus));
+	bus->dev = dev;
+
+	bus->rst_gpio = devm_gpiod_get_optional(dev, "rst", GPIOD_OUT_LOW);
+	if (IS_ERR(bus->rst_gpio)) {
+		ret = PTR_ERR(bus->rst_gpio);
+		dev_err(dev, "rst GPIO: %d\n", ret);
+		return ret;
+	}
+
+	bus->dc_gpio = devm_gpiod_get(dev, "dc", GPIOD_OUT_LOW);
+	if (IS_ERR(bus->dc_gpio)) {
+		ret = PTR_ERR(bus->dc_gpio);
+		dev_err(dev, "dc GPIO: %d\n", ret);
+		return ret;
+	}
+
+	bus->wr_gpio = devm_gpiod_get(dev, "wr", GPIOD_OUT_LOW);
+	if (IS_ERR(bus->wr_gpio)) {
+		ret = PTR_ERR(bus->wr_gpio);
+		dev_err(dev, "wr GPIO: %d\n", ret);
+		return ret;
+	}
+
+	bus->data_gpios = devm_gpiod_get_array(dev, "data", GPIOD_OUT_LOW);
+	if (IS_ERR(bus->data_gpios)) {
+		ret = PTR_ERR(bus->data_gpios);
+		dev_err(dev, "data GPIOs: %d\n", ret);
+		return ret;
+	}
+	if (bus->data_gpios->ndescs != 16 && bus->data_gpios->ndescs != 8) {
+		dev_err(dev, "need 8 or 16 data GPIOs, got %u\n",
+			bus->data_gpios->ndescs);
+		return -EINVAL;
+	}
+	bus->width = bus->data_gpios->ndescs;
+	bus->low_colour = of_property_read_bool(dev->of_node, "low-colour");
+	if (bus->low_colour && bus->width == 16) {
+		dev_err(dev, "low-colour needs an 8-bit data bus\n");
+		return -EINVAL;
+	}
+
+	/* 26-pin shields also wire /CS and /RD: select the chip, never read */
+	bus->cs_gpio = devm_gpiod_get_optional(dev, "cs", GPIOD_OUT_HIGH);
+	if (IS_ERR(bus->cs_gpio)) {
+		ret = PTR_ERR(bus->cs_gpio);
+		dev_err(dev, "cs GPIO: %d\n", ret);
+		return ret;
+	}
+
+	bus->rd_gpio = devm_gpiod_get_optional(dev, "rd", GPIOD_OUT_LOW);
+	if (IS_ERR(bus->rd_gpio)) {
+		ret = PTR_ERR(bus->rd_gpio);
+		dev_err(dev, "rd GPIO: %d\n", ret);
+		return ret;
+	}
+
+	ili9481_setup_fast_io(bus);
+	ili9481_setup_timing(bus);
+
+	if (calibrate)
+		ili9481_calibrate(bus);
+	return 0;
+}
+EXPORT_SYMBOL_GPL(ili9481_bus_init);
+
+/* ================================================================== */
+/* Hardware reset and initialisation                                  */
+/* ================================================================== */
+
+static void ili9481_hw_reset(struct ili9481_bus *bus)
+{
+	if (!bus->rst_gpio)
+		return;
+
+	gpiod_set_value(bus->rst_gpio, 1);	/* assert reset  */
+	msleep(20);
+	gpiod_set_value(bus->rst_gpio, 0);	/* release reset */
+	msleep(20);
+}
+
+void ili9481_bus_init_display(struct ili9481_bus *bus, u32 rotate)
+{
+	unsigned int i, j;
+
+	ili9481_hw_reset(bus);
+
+	for (i = 0; i < ILI9481_INIT_CMD_COUNT; i++) {
+		const struct ili9481_reg_cmd *c = &ili9481_init_cmds[i];
+
+		ili9481_bus_write_cmd(bus, c->cmd);
+		for (j = 0; j < c->len; j++)
+			ili9481_bus_write_data(bus, c->data[j]);
+		if (c->delay_ms)
+			msleep(c->delay_ms);
+	}
+
+	/* Apply rotation */
+	ili9481_bus_write_cmd(bus, ILI9481_MADCTL);
+	ili9481_bus_write_data(bus, ili9481_madctl_for_rotate(rotate));
+
+	/* Low-colour: 3 bpp transfers, and idle mode to save panel power */
+	if (bus->low_colour) {
+		ili9481_bus_write_cmd(bus, ILI9481_COLMOD);
+		ili9481_bus_write_data(bus, ILI9481_COLMOD_3BIT);
+		ili9481_bus_write_cmd(bus, ILI9481_IDMON);
+	}
+}
+EXPORT_SYMBOL_GPL(ili9481_bus_init_display);
+
+void ili9481_bus_power_off(struct ili9481_bus *bus)
+{
+	ili9481_bus_write_cmd(bus, ILI9481_DISPOFF);
+	ili9481_bus_write_cmd(bus, ILI9481_SLPIN);
+}
+EXPORT_SYMBOL_GPL(ili9481_bus_power_off);
+
+/* ================================================================== */
+/* Windowed pixel writes                                              */
+/* ================================================================== */
+
+/* Set the CASET/PASET address window (inclusive bounds). */
+static void ili9481_set_window(struct ili9481_bus *bus,
+			       u32 x0, u32 y0, u32 x1, u32 y1)
+{
+	ili9481_bus_write_cmd(bus, ILI9481_CASET);
+	ili9481_bus_write_data(bus, x0 >> 8);
+	ili9481_bus_write_data(bus, x0 & 0xFF);
+	ili9481_bus_write_data(bus, x1 >> 8);
+	ili9481_bus_write_data(bus, x1 & 0xFF);
+
+	ili9481_bus_write_cmd(bus, ILI9481_PASET);
+	ili9481_bus_write_data(bus, y0 >> 8);
+	ili9481_bus_write_data(bus, y0 & 0xFF);
+	ili9481_bus_write_data(bus, y1 >> 8);
+	ili9481_bus_write_data(bus, y1 & 0xFF);
+}
+
+void ili9481_bus_write_rect(struct ili9481_bus *bus, const u16 *px, u32 pitch,
+			    u32 x, u32 y, u32 w, u32 h)
+{
+	u32 row;
+
+	ili9481_set_window(bus, x, y, x + w - 1, y + h - 1);
+	ili9481_bus_write_cmd(bus, ILI9481_RAMWR);
+
+	/* Contiguous rows: one span for the lot */
+	if (pitch == w) {
+		ili9481_write_span(bus, px, w * h);
+		return;
+	}
+
+	for (row = 0; row < h; row++)
+		ili9481_write_span(bus, px + row * pitch, w);
+}
+EXPORT_SYMBOL_GPL(ili9481_bus_write_rect);
+
+MODULE_AUTHOR("ILI9481-driver contributors");
+MODULE_DESCRIPTION(DRIVER_DESC);
+MODULE_LICENSE("GPL");
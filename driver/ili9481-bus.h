@@ -0,0 +1,114 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * ili9481-bus.h — 8080-parallel GPIO bus shared by the ILI9481 drivers
+ *
+ * ili9481-bus.ko owns the bit-bang code: GPIO acquisition, the BCM2835
+ * direct-register fast path, the panel init sequence and windowed pixel
+ * writes.  The fbdev (ili9481-gpio) and DRM (ili9481-drm) front ends both
+ * drive the panel through it.
+ */
+
+#ifndef ILI9481_BUS_H
+#define ILI9481_BUS_H
+
+#include <linux/align.h>
+#include <linux/types.h>
+
+struct device;
+struct gpio_desc;
+struct gpio_descs;
+
+/**
+ * struct ili9481_bus - GPIO lines and fast-path state of one panel
+ * @dev:        device the GPIOs were requested for
+ * @data_gpios: DB0–DB15, or DB0–DB7 on an 8-bit bus
+ * @dc_gpio:    RS / DC
+ * @wr_gpio:    /WR (write strobe)
+ * @rst_gpio:   /RST (optional)
+ * @cs_gpio:    /CS (optional, held asserted)
+ * @rd_gpio:    /RD (optional, held de-asserted)
+ * @width:      data bus width, 16 or 8 (two strobes per pixel)
+ * @low_colour: 3 bpp transfers (DT "low-colour", 8-bit bus only), see
+ *              ili9481_bus_align()
+ * @gpio_set:   GPSETn for the pins' bank, NULL if the gpiod path is in use
+ * @gpio_clr:   GPCLRn for the pins' bank
+ * @wr_mask:    /WR bit in @gpio_set / @gpio_clr
+ * @lut_set:    pin masks to set for a 16-bit value: [0][low] | [1][high]
+ *              ([1] is all zero on an 8-bit bus)
+ * @lut_clr:    pin masks to clear, same layout as @lut_set
+ * @wr_low_ns:  extra /WR low hold per write (DT "wr-low-ns")
+ * @wr_high_ns: extra /WR high hold per write (DT "wr-high-ns")
+ */
+struct ili9481_bus {
+	struct device		*dev;
+	struct gpio_descs	*data_gpios;
+	struct gpio_desc	*dc_gpio;
+	struct gpio_desc	*wr_gpio;
+	struct gpio_desc	*rst_gpio;
+	struct gpio_desc	*cs_gpio;
+	struct gpio_desc	*rd_gpio;
+	u32			 width;
+	bool			 low_colour;
+
+	void __iomem		*gpio_set;
+	void __iomem		*gpio_clr;
+	u32			 wr_mask;
+	u32			 lut_set[2][256];
+	u32			 lut_clr[2][256];
+
+	u32			 wr_low_ns;
+	u32			 wr_high_ns;
+};
+
+/*
+ * ili9481_bus_init() — Request the rst/dc/wr/data GPIOs of @dev (all
+ *                      device-managed), set up the fast path if the
+ *                      wiring allows it and read the strobe timing.
+ *                      Returns 0 or -errno.
+ */
+int ili9481_bus_init(struct ili9481_bus *bus, struct device *dev);
+
+/* ili9481_bus_write_cmd() — Send a command byte (DC low) */
+void ili9481_bus_write_cmd(struct ili9481_bus *bus, u8 cmd);
+
+/* ili9481_bus_write_data() — Send a parameter byte (DC high) */
+void ili9481_bus_write_data(struct ili9481_bus *bus, u8 data);
+
+/*
+ * ili9481_bus_init_display() — Hardware reset, run the init table and
+ *                              apply the MADCTL for @rotate.
+ */
+void ili9481_bus_init_display(struct ili9481_bus *bus, u32 rotate);
+
+/*
+ * ili9481_bus_write_rect() — Stream a w×h RGB565 rectangle at (x, y).
+ *
+ * @px is the rectangle's top-left pixel and @pitch the source line length
+ * in pixels; when @pitch == @w the rows are sent as a single span.
+ */
+void ili9481_bus_write_rect(struct ili9481_bus *bus, const u16 *px, u32 pitch,
+			    u32 x, u32 y, u32 w, u32 h);
+
+/*
+ * ili9481_bus_align() — Widen a span of columns for the transfer format.
+ *
+ * In low-colour mode two pixels share a byte, so every window must start
+ * on an even column and be an even number of pixels wide; otherwise the
+ * padding pixel would wrap around to the window's start.  Callers round
+ * each rectangle with this before ili9481_bus_write_rect().  Panel widths
+ * are even, so the result stays on screen.
+ */
+static inline void ili9481_bus_align(const struct ili9481_bus *bus,
+				     u32 *x, u32 *w)
+{
+	if (!bus->low_colour)
+		return;
+
+	*w = ALIGN(*w + (*x & 1), 2);
+	*x &= ~1U;
+}
+
+/* ili9481_bus_power_off() — Display off and enter sleep */
+void ili9481_bus_power_off(struct ili9481_bus *bus);
+
+#endif /* ILI9481_BUS_H */
@@ -0,0 +1,401 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * ili9481-drm.c — ILI9481 parallel GPIO panel as a DRM/KMS device
+ *
+ * A tiny simple-display-pipe driver in the style of the mipi_dbi panels,
+ * built on the same bit-bang bus (ili9481-bus.ko) as the fbdev driver.
+ * Userspace gets dumb buffers, atomic modesetting and page flips; every
+ * plane update is flushed as the merged damage clip of the commit, so
+ * only the changed rectangle crosses the bus.  There is no timer: a flip
+ * completes once its damage has been written, which paces clients to
+ * what the bus can actually carry.
+ *
+ * Bind via device-tree: compatible = "inland,ili9481-drm";
+ * (same properties as "inland,ili9481-gpio", minus fps).
+ *
+ * Copyright 2025  ILI9481-driver contributors
+ */
+
+#include <linux/module.h>
+#include <linux/kernel.h>
+#include <linux/platform_device.h>
+#include <linux/of.h>
+#include <linux/dma-buf.h>
+#include <linux/iosys-map.h>
+
+#include <drm/drm_atomic_helper.h>
+#include <drm/drm_connector.h>
+#include <drm/drm_damage_helper.h>
+#include <drm/drm_drv.h>
+#include <drm/drm_fbdev_dma.h>
+#include <drm/drm_format_helper.h>
+#include <drm/drm_fourcc.h>
+#include <drm/drm_framebuffer.h>
+#include <drm/drm_gem_atomic_helper.h>
+#include <drm/drm_gem_dma_helper.h>
+#include <drm/drm_gem_framebuffer_helper.h>
+#include <drm/drm_managed.h>
+#include <drm/drm_modes.h>
+#include <drm/drm_probe_helper.h>
+#include <drm/drm_rect.h>
+#include <drm/drm_simple_kms_helper.h>
+
+#include "ili9481-gpio.h"
+#include "ili9481-bus.h"
+
+#define DRIVER_NAME	"ili9481-drm"
+#define DRIVER_DESC	"ILI9481 parallel GPIO DRM driver"
+
+/* 3.5" panel active area */
+#define ILI9481_WIDTH_MM	49
+#define ILI9481_HEIGHT_MM	73
+
+/* ================================================================== */
+/* Private state                                                      */
+/* ================================================================== */
+
+struct ili9481_drm {
+	struct drm_device		 drm;
+	struct drm_simple_display_pipe	 pipe;
+	struct drm_connector		 connector;
+	struct drm_display_mode		 mode;
+	struct ili9481_bus		 bus;
+	u32				 rotate;
+	u16				*tx_buf;	/* one frame, RGB565 */
+};
+
+static inline struct ili9481_drm *to_ili9481_drm(struct drm_device *drm)
+{
+	return container_of(drm, struct ili9481_drm, drm);
+}
+
+/* ================================================================== */
+/* Damage flush                                                       */
+/* ================================================================== */
+
+/*
+ * Convert the @damage part of @fb (widened for the transfer format) into
+ * tx_buf (packed, RGB565) and stream it to the panel as one
+ * CASET/PASET/RAMWR window.
+ */
+static void ili9481_drm_fb_dirty(struct ili9481_drm *idev,
+				 const struct iosys_map *src,
+				 struct drm_framebuffer *fb,
+				 const struct drm_rect *damage,
+				 struct drm_format_conv_state *fmtcnv_state)
+{
+	struct drm_rect rect = *damage;
+	u32 x = rect.x1, w = drm_rect_width(&rect), h = drm_rect_height(&rect);
+	unsigned int pitch;
+	struct iosys_map dst;
+	int idx, ret;
+
+	ili9481_bus_align(&idev->bus, &x, &w);
+	rect.x1 = x;
+	rect.x2 = x + w;
+	pitch = w * sizeof(u16);
+
+	if (!drm_dev_enter(fb->dev, &idx))
+		return;
+
+	ret = drm_gem_fb_begin_cpu_access(fb, DMA_FROM_DEVICE);
+	if (ret)
+		goto out_exit;
+
+	iosys_map_set_vaddr(&dst, idev->tx_buf);
+	switch (fb->format->format) {
+	case DRM_FORMAT_RGB565:
+		drm_fb_memcpy(&dst, &pitch, src, fb, &rect);
+		break;
+	case DRM_FORMAT_XRGB8888:
+		drm_fb_xrgb8888_to_rgb565(&dst, &pitch, src, fb, &rect,
+					  fmtcnv_state, false);
+		break;
+	default:
+		drm_err_once(fb->dev, "unsupported format %p4cc\n",
+			     &fb->format->format);
+		ret = -EINVAL;
+	}
+
+	drm_gem_fb_end_cpu_access(fb, DMA_FROM_DEVICE);
+
+	if (!ret)
+		ili9481_bus_write_rect(&idev->bus, idev->tx_buf, w,
+				       rect.x1, rect.y1, w, h);
+out_exit:
+	drm_dev_exit(idx);
+}
+
+/* ================================================================== */
+/* Simple display pipe                                                */
+/* ================================================================== */
+
+static enum drm_mode_status
+ili9481_drm_pipe_mode_valid(struct drm_simple_display_pipe *pipe,
+			    const struct drm_display_mode *mode)
+{
+	struct ili9481_drm *idev = to_ili9481_drm(pipe->crtc.dev);
+
+	return drm_crtc_helper_mode_valid_fixed(&pipe->crtc, mode, &idev->mode);
+}
+
+static void ili9481_drm_pipe_enable(struct drm_simple_display_pipe *pipe,
+				    struct drm_crtc_state *crtc_state,
+				    struct drm_plane_state *plane_state)
+{
+	struct ili9481_drm *idev = to_ili9481_drm(pipe->crtc.dev);
+	struct drm_shadow_plane_state *shadow_plane_state =
+		to_drm_shadow_plane_state(plane_state);
+	struct drm_framebuffer *fb = plane_state->fb;
+	struct drm_rect rect = {
+		.x1 = 0, .y1 = 0,
+		.x2 = idev->mode.hdisplay, .y2 = idev->mode.vdisplay,
+	};
+	int idx;
+
+	if (!drm_dev_enter(pipe->crtc.dev, &idx))
+		return;
+
+	ili9481_bus_init_display(&idev->bus, idev->rotate);
+	drm_dev_exit(idx);
+
+	/* Panel RAM is undefined after reset: send the whole frame */
+	if (fb)
+		ili9481_drm_fb_dirty(idev, &shadow_plane_state->data[0], fb,
+				     &rect, &shadow_plane_state->fmtcnv_state);
+}
+
+static void ili9481_drm_pipe_disable(struct drm_simple_display_pipe *pipe)
+{
+	struct ili9481_drm *idev = to_ili9481_drm(pipe->crtc.dev);
+	int idx;
+
+	if (!drm_dev_enter(pipe->crtc.dev, &idx))
+		return;
+
+	ili9481_bus_power_off(&idev->bus);
+	drm_dev_exit(idx);
+}
+
+static void ili9481_drm_pipe_update(struct drm_simple_display_pipe *pipe,
+				    struct drm_plane_state *old_state)
+{
+	struct ili9481_drm *idev = to_ili9481_drm(pipe->crtc.dev);
+	struct drm_plane_state *state = pipe->plane.state;
+	struct drm_shadow_plane_state *shadow_plane_state =
+		to_drm_shadow_plane_state(state);
+	struct drm_framebuffer *fb = state->fb;
+	struct drm_rect rect;
+
+	if (!pipe->crtc.state->active || !fb)
+		return;
+
+	if (drm_atomic_helper_damage_merged(old_state, state, &rect))
+		ili9481_drm_fb_dirty(idev, &shadow_plane_state->data[0], fb,
+				     &rect, &shadow_plane_state->fmtcnv_state);
+}
+
+static const struct drm_simple_display_pipe_funcs ili9481_drm_pipe_funcs = {
+	.mode_valid = ili9481_drm_pipe_mode_valid,
+	.enable     = ili9481_drm_pipe_enable,
+	.disable    = ili9481_drm_pipe_disable,
+	.update     = ili9481_drm_pipe_update,
+	DRM_GEM_SIMPLE_DISPLAY_PIPE_SHADOW_PLANE_FUNCS,
+};
+
+static const u32 ili9481_drm_formats[] = {
+	DRM_FORMAT_RGB565,
+	DRM_FORMAT_XRGB8888,
+};
+
+/* ================================================================== */
+/* Connector — one fixed mode                                         */
+/* ================================================================== */
+
+static int ili9481_drm_connector_get_modes(struct drm_connector *connector)
+{
+	struct ili9481_drm *idev = to_ili9481_drm(connector->dev);
+
+	return drm_connector_helper_get_modes_fixed(connector, &idev->mode);
+}
+
+static const struct drm_connector_helper_funcs ili9481_drm_connector_hfuncs = {
+	.get_modes = ili9481_drm_connector_get_modes,
+};
+
+static const struct drm_connector_funcs ili9481_drm_connector_funcs = {
+	.reset                  = drm_atomic_helper_connector_reset,
+	.fill_modes             = drm_helper_probe_single_connector_modes,
+	.destroy                = drm_connector_cleanup,
+	.atomic_duplicate_state = drm_atomic_helper_connector_duplicate_state,
+	.atomic_destroy_state   = drm_atomic_helper_connector_destroy_state,
+};
+
+static const struct drm_mode_config_funcs ili9481_drm_mode_config_funcs = {
+	.fb_create     = drm_gem_fb_create_with_dirty,
+	.atomic_check  = drm_atomic_helper_check,
+	.atomic_commit = drm_atomic_helper_commit,
+};
+
+/* ================================================================== */
+/* DRM driver                                                         */
+/* ================================================================== */
+
+DEFINE_DRM_GEM_DMA_FOPS(ili9481_drm_fops);
+
+static const struct drm_driver ili9481_drm_driver = {
+	.driver_features = DRIVER_GEM | DRIVER_MODESET | DRIVER_ATOMIC,
+	.fops            = &ili9481_drm_fops,
+	DRM_GEM_DMA_DRIVER_OPS_VMAP,
+	.name            = "ili9481",
+	.desc            = DRIVER_DESC,
+	.date            = "20250101",
+	.major           = 1,
+	.minor           = 0,
+};
+
+/* ================================================================== */
+/* Platform driver probe                                              */
+/* ================================================================== */
+
+static int ili9481_drm_probe(struct platform_device *pdev)
+{
+	struct device *dev = &pdev->dev;
+	struct ili9481_drm *idev;
+	struct drm_device *drm;
+	u32 width, height;
+	int ret;
+
+	idev = devm_drm_dev_alloc(dev, &ili9481_drm_driver,
+				  struct ili9481_drm, drm);
+	if (IS_ERR(idev))
+		return PTR_ERR(idev);
+	drm = &idev->drm;
+
+	/* ----- Device-tree properties ----- */
+	if (of_property_read_u32(dev->of_node, "rotate", &idev->rotate))
+		idev->rotate = 270;
+
+	switch (idev->rotate) {
+	case 90:
+	case 270:
+		width  = ILI9481_HEIGHT;	/* 480 */
+		height = ILI9481_WIDTH;		/* 320 */
+		break;
+	default:
+		width  = ILI9481_WIDTH;		/* 320 */
+		height = ILI9481_HEIGHT;	/* 480 */
+		break;
+	}
+
+	/* ----- Bus ----- */
+	ret = ili9481_bus_init(&idev->bus, dev);
+	if (ret)
+		return ret;
+
+	idev->tx_buf = devm_kmalloc(dev, width * height * sizeof(u16),
+				    GFP_KERNEL);
+	if (!idev->tx_buf)
+		return -ENOMEM;
+
+	/* ----- Mode, connector and pipe ----- */
+	if (width > height)
+		idev->mode = (struct drm_display_mode) {
+			DRM_SIMPLE_MODE(width, height,
+					ILI9481_HEIGHT_MM, ILI9481_WIDTH_MM)
+		};
+	else
+		idev->mode = (struct drm_display_mode) {
+			DRM_SIMPLE_MODE(width, height,
+					ILI9481_WIDTH_MM, ILI9481_HEIGHT_MM)
+		};
+
+	ret = drmm_mode_config_init(drm);
+	if (ret)
+		return ret;
+
+	drm->mode_config.min_width  = width;
+	drm->mode_config.max_width  = width;
+	drm->mode_config.min_height = height;
+	drm->mode_config.max_height = height;
+	drm->mode_config.funcs      = &ili9481_drm_mode_config_funcs;
+	drm->mode_config.preferred_depth = 16;
+
+	drm_connector_helper_add(&idev->connector,
+				 &ili9481_drm_connector_hfuncs);
+	ret = drm_connector_init(drm, &idev->connector,
+				 &ili9481_drm_connector_funcs,
+				 DRM_MODE_CONNECTOR_DPI);
+	if (ret)
+		return ret;
+
+	ret = drm_simple_display_pipe_init(drm, &idev->pipe,
+					   &ili9481_drm_pipe_funcs,
+					   ili9481_drm_formats,
+					   ARRAY_SIZE(ili9481_drm_formats),
+					   NULL, &idev->connector);
+	if (ret)
+		return ret;
+
+	drm_plane_enable_fb_damage_clips(&idev->pipe.plane);
+	drm_mode_config_reset(drm);
+
+	/* ----- Register ----- */
+	ret = drm_dev_register(drm, 0);
+	if (ret) {
+		dev_err(dev, "drm_dev_register failed: %d\n", ret);
+		return ret;
+	}
+
+	platform_set_drvdata(pdev, drm);
+
+	/* fbcon and /dev/fbN clients keep working through fbdev emulation */
+	drm_fbdev_dma_setup(drm, 16);
+
+	dev_info(dev, "ILI9481 %ux%u DRM card%d registered (rotate=%u)\n",
+		 width, height, drm->primary->index, idev->rotate);
+
+	return 0;
+}
+
+/* ================================================================== */
+/* Platform driver remove / shutdown                                  */
+/* ================================================================== */
+
+static void ili9481_drm_remove(struct platform_device *pdev)
+{
+	struct drm_device *drm = platform_get_drvdata(pdev);
+
+	drm_dev_unplug(drm);
+	drm_atomic_helper_shutdown(drm);
+}
+
+static void ili9481_drm_shutdown(struct platform_device *pdev)
+{
+	drm_atomic_helper_shutdown(platform_get_drvdata(pdev));
+}
+
+/* ================================================================== */
+/* Device-tree match and module boilerplate                           */
+/* ================================================================== */
+
+static const struct of_device_id ili9481_drm_of_match[] = {
+	{ .compatible = "inland,ili9481-drm" },
+	{ /* sentinel */ }
+};
+MODULE_DEVICE_TABLE(of, ili9481_drm_of_match);
+
+static struct platform_driver ili9481_drm_platform_driver = {
+	.driver = {
+		.name           = DRIVER_NAME,
+		.of_match_table = ili9481_drm_of_match,
+	},
+	.probe    = ili9481_drm_probe,
+	.remove   = ili9481_drm_remove,
+	.shutdown = ili9481_drm_shutdown,
+};
+module_platform_driver(ili9481_drm_platform_driver);
+
+MODULE_AUTHOR("ILI9481-driver contributors");
+MODULE_DESCRIPTION(DRIVER_DESC);
+MODULE_LICENSE("GPL");
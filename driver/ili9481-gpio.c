@@ -1,13 +1,17 @@
 // SPDX-License-Identifier: GPL-2.0-only
 /*
- * ili9481-gpio.c — Self-contained ILI9481 16-bit parallel GPIO framebuffer driver
+ * ili9481-gpio.c — ILI9481 parallel GPIO framebuffer driver (fbdev)
  *
  * Drives Inland TFT35 (and compatible Kedei-style) 320×480 shields that use a
- * 16-bit 8080-parallel bus over Raspberry Pi GPIO, with 74HC245 level shifters.
+ * 16-bit 8080-parallel bus over Raspberry Pi GPIO, with 74HC245 level shifters,
+ * and the 26-pin shields with an 8-bit bus (8 data-gpios in the DT node).
  *
  * Designed for kernel 6.12+ — uses gpiod descriptor API, deferred fb IO, and
  * the modern platform-driver remove (void return) convention.
  *
+ * The bus itself lives in ili9481-bus.ko; ili9481-drm.ko is the DRM/KMS
+ * alternative for the same panel.
+ *
  * Bind via device-tree: compatible = "inland,ili9481-gpio";
  *
  * Copyright 2025  ILI9481-driver contributors
@@ -18,167 +22,296 @@
 #include <linux/platform_device.h>
 #include <linux/of.h>
 #include <linux/fb.h>
-#include <linux/gpio/consumer.h>
-#include <linux/delay.h>
 #include <linux/vmalloc.h>
 #include <linux/mm.h>
 #include <linux/slab.h>
 #include <linux/workqueue.h>
+#include <linux/kthread.h>
+#include <linux/sched.h>
+#include <linux/cpumask.h>
+#include <linux/bitmap.h>
+#include <linux/debugfs.h>
+#include <linux/seq_file.h>
+#include <linux/ktime.h>
+#include <linux/spinlock.h>
+#include <linux/math64.h>
 #include <linux/version.h>
 
 #include "ili9481-gpio.h"
+#include "ili9481-bus.h"
 
 #define DRIVER_NAME	"ili9481-gpio"
-#define DRIVER_DESC	"ILI9481 16-bit parallel GPIO framebuffer"
+#define DRIVER_DESC	"ILI9481 parallel GPIO framebuffer"
+
+static bool flush_thread;
+module_param(flush_thread, bool, 0444);
+MODULE_PARM_DESC(flush_thread,
+		 "Flush on a dedicated SCHED_FIFO kthread instead of the system workqueue (default: false)");
 
 /* ================================================================== */
 /* Private state                                                      */
 /* ================================================================== */
 
+/*
+ * Flush latency histogram: bucket i counts flushes shorter than
+ * ILI9481_HIST_BASE_US << i; the last bucket takes everything longer.
+ */
+#define ILI9481_HIST_BASE_US	128
+#define ILI9481_HIST_BUCKETS	12
+
+/*
+ * Flush statistics, shown in debugfs.  Written from the flush context,
+ * the deferred-IO callback and any drawing context, and read or zeroed
+ * from debugfs, so every access holds stats_lock; a reader never sees a
+ * half-updated flush.  All of them mean the same with and without
+ * flush_thread.
+ */
+struct ili9481_stats {
+	u64			 flushes;	/* flushes that wrote pixels    */
+	u64			 pixels;	/* pixels sent to the panel     */
+	u64			 ns_total;
+	u64			 ns_min;
+	u64			 ns_max;
+	u64			 hist[ILI9481_HIST_BUCKETS];
+	u64			 defio_runs;	/* deferred-IO callbacks        */
+	u64			 mmap_pages;	/* pages written through mmap   */
+	u64			 runs_merged;	/* ... flush already queued     */
+	u64			 draws;		/* fb_ops draw requests         */
+	u64			 draws_merged;	/* ... callback already pending */
+};
+
 struct ili9481_priv {
 	struct fb_info		*info;
 	struct device		*dev;
-	struct gpio_descs	*data_gpios;	/* DB0–DB15 (16 pins)  */
-	struct gpio_desc	*dc_gpio;	/* RS / DC             */
-	struct gpio_desc	*wr_gpio;	/* /WR  (write strobe) */
-	struct gpio_desc	*rst_gpio;	/* /RST (optional)     */
+	struct ili9481_bus	 bus;
 	u32			 width;
 	u32			 height;
 	u32			 rotate;
 	u32			 fps;
+
+	/* Damage since the last flush, under damage_lock */
+	spinlock_t		 damage_lock;
+	bool			 damaged;
+	u32			 dmg_x0, dmg_y0;	/* inclusive */
+	u32			 dmg_x1, dmg_y1;	/* inclusive */
+	DECLARE_BITMAP(dirty_rows, ILI9481_HEIGHT);	/* mmap'd pages */
+
+	/* Flush statistics, under stats_lock */
+	spinlock_t		 stats_lock;
+	struct ili9481_stats	 stats;
+	struct dentry		*debugfs;
+
+	/* Dedicated flush thread (flush_thread=1), NULL otherwise */
+	struct kthread_worker	*worker;
+	struct kthread_work	 flush_work;
 };
 
 /* ================================================================== */
-/* GPIO bit-bang write helpers                                        */
+/* Framebuffer flush (deferred-IO callback)                           */
 /* ================================================================== */
 
 /*
- * Write a raw 16-bit value onto DB0–DB15 and pulse /WR.
- *
- * 8080-style timing (active-low WR in DTS):
- *   1.  Place data on bus
- *   2.  Assert /WR  (gpiod logical 1 → pin LOW)
- *   3.  Hold ≥ 15 ns  (ILI9481 tWRL)
- *   4.  De-assert /WR (gpiod logical 0 → pin HIGH, rising edge latches data)
+ * Stream a w×h rectangle of the shadow framebuffer to the panel; returns
+ * the number of pixels sent.
  */
-static inline void ili9481_write16(struct ili9481_priv *par, u16 val)
+static u32 ili9481_write_rect(struct ili9481_priv *par,
+			      u32 x, u32 y, u32 w, u32 h)
 {
-	DECLARE_BITMAP(bits, 16);
-
-	bits[0] = val;
+	const u16 *vmem = (const u16 *)par->info->screen_buffer;
 
-	gpiod_set_array_value(par->data_gpios->ndescs,
-			      par->data_gpios->desc,
-			      par->data_gpios->info,
-			      bits);
-
-	gpiod_set_value(par->wr_gpio, 1);	/* /WR LOW  (assert)   */
-	ndelay(15);
-	gpiod_set_value(par->wr_gpio, 0);	/* /WR HIGH (latch)    */
+	ili9481_bus_align(&par->bus, &x, &w);
+	ili9481_bus_write_rect(&par->bus, vmem + y * par->width + x,
+			       par->width, x, y, w, h);
+	return w * h;
 }
 
-/* Send a command byte (DC low, 8-bit zero-extended to 16 bits). */
-static void ili9481_write_cmd(struct ili9481_priv *par, u8 cmd)
+/* Add @n to the statistics counter @ctr. */
+static void ili9481_stats_add(struct ili9481_priv *par, u64 *ctr, u64 n)
 {
-	gpiod_set_value(par->dc_gpio, 0);	/* command mode */
-	ili9481_write16(par, cmd);
-	gpiod_set_value(par->dc_gpio, 1);	/* back to data mode */
-}
+	unsigned long flags;
 
-/* Send an 8-bit data/parameter byte (DC high). */
-static void ili9481_write_data(struct ili9481_priv *par, u8 data)
-{
-	ili9481_write16(par, data);
+	spin_lock_irqsave(&par->stats_lock, flags);
+	*ctr += n;
+	spin_unlock_irqrestore(&par->stats_lock, flags);
 }
 
-/* Send a 16-bit pixel value (DC high). */
-static void ili9481_write_pixel(struct ili9481_priv *par, u16 pixel)
+/* Account one flush of @pixels that took @ns. */
+static void ili9481_stats_flush(struct ili9481_priv *par, u64 pixels, u64 ns)
 {
-	ili9481_write16(par, pixel);
+	struct ili9481_stats *st = &par->stats;
+	u64 us = div_u64(ns, NSEC_PER_USEC);
+	unsigned long flags;
+	unsigned int b = 0;
+
+	while (b < ILI9481_HIST_BUCKETS - 1 &&
+	       us >= (u64)ILI9481_HIST_BASE_US << b)
+		b++;
+
+	spin_lock_irqsave(&par->stats_lock, flags);
+	st->hist[b]++;
+	st->pixels += pixels;
+	st->ns_total += ns;
+	st->ns_min = st->flushes ? min(st->ns_min, ns) : ns;
+	st->ns_max = max(st->ns_max, ns);
+	st->flushes++;
+	spin_unlock_irqrestore(&par->stats_lock, flags);
 }
 
-/* ================================================================== */
-/* Hardware reset and initialisation                                  */
-/* ================================================================== */
-
-static void ili9481_hw_reset(struct ili9481_priv *par)
+/*
+ * Write out everything pending: the union rectangle recorded by the
+ * fb_ops draw paths, then each run of dirty rows as one band of
+ * full-width rows (one PASET/RAMWR window per band).  Both are taken
+ * and cleared in one go, so damage that piles up while a flush is in
+ * progress is coalesced into the next one.
+ */
+static void ili9481_flush_pending(struct ili9481_priv *par)
 {
-	if (!par->rst_gpio)
+	DECLARE_BITMAP(rows, ILI9481_HEIGHT);
+	u32 dx0, dy0, dx1, dy1;
+	unsigned int y0, y1;
+	bool damaged;
+	unsigned long flags;
+	u64 pixels = 0;
+	u64 t0;
+
+	spin_lock_irqsave(&par->damage_lock, flags);
+	damaged = par->damaged;
+	dx0 = par->dmg_x0;
+	dy0 = par->dmg_y0;
+	dx1 = par->dmg_x1;
+	dy1 = par->dmg_y1;
+	par->damaged = false;
+	bitmap_copy(rows, par->dirty_rows, par->height);
+	bitmap_zero(par->dirty_rows, par->height);
+	spin_unlock_irqrestore(&par->damage_lock, flags);
+
+	if (!damaged && bitmap_empty(rows, par->height))
 		return;
 
-	gpiod_set_value(par->rst_gpio, 1);	/* assert reset  */
-	msleep(20);
-	gpiod_set_value(par->rst_gpio, 0);	/* release reset */
-	msleep(20);
-}
+	t0 = ktime_get_ns();
 
-static void ili9481_init_display(struct ili9481_priv *par)
-{
-	unsigned int i, j;
+	if (damaged)
+		pixels += ili9481_write_rect(par, dx0, dy0,
+					     dx1 - dx0 + 1, dy1 - dy0 + 1);
 
-	ili9481_hw_reset(par);
+	for_each_set_bitrange(y0, y1, rows, par->height)
+		pixels += ili9481_write_rect(par, 0, y0, par->width, y1 - y0);
 
-	for (i = 0; i < ILI9481_INIT_CMD_COUNT; i++) {
-		const struct ili9481_reg_cmd *c = &ili9481_init_cmds[i];
+	ili9481_stats_flush(par, pixels, ktime_get_ns() - t0);
+}
 
-		ili9481_write_cmd(par, c->cmd);
-		for (j = 0; j < c->len; j++)
-			ili9481_write_data(par, c->data[j]);
-		if (c->delay_ms)
-			msleep(c->delay_ms);
-	}
+static void ili9481_flush_work(struct kthread_work *work)
+{
+	struct ili9481_priv *par = container_of(work, struct ili9481_priv,
+						flush_work);
 
-	/* Apply rotation */
-	ili9481_write_cmd(par, ILI9481_MADCTL);
-	ili9481_write_data(par, ili9481_madctl_for_rotate(par->rotate));
+	ili9481_flush_pending(par);
 }
 
-/* ================================================================== */
-/* Framebuffer flush (deferred-IO callback)                           */
-/* ================================================================== */
-
+/*
+ * Deferred-IO callback.  Each entry of @pagereflist is one page of video
+ * memory that was written through an mmap since the last flush; its rows
+ * are marked in dirty_rows, where overlapping or adjacent pages merge
+ * into bands.
+ *
+ * Drawing through fb_write/fillrect/copyarea/imageblit does not touch any
+ * mapped page; those paths record their rectangle with ili9481_damage()
+ * and schedule this callback too.
+ *
+ * By default the bus is driven right here, on the system workqueue.  With
+ * flush_thread=1 the callback only records rows and wakes the driver's
+ * SCHED_FIFO worker, which flushes whatever has accumulated by the time
+ * it runs.
+ */
 static void ili9481_flush(struct fb_info *info,
 			  struct list_head *pagereflist)
 {
 	struct ili9481_priv *par = info->par;
-	u16 *vmem = (u16 *)info->screen_buffer;
-	unsigned int npixels, i;
-
-	/* Column address range — full width */
-	ili9481_write_cmd(par, ILI9481_CASET);
-	ili9481_write_data(par, 0x00);
-	ili9481_write_data(par, 0x00);
-	ili9481_write_data(par, (par->width - 1) >> 8);
-	ili9481_write_data(par, (par->width - 1) & 0xFF);
-
-	/* Page (row) address range — full height */
-	ili9481_write_cmd(par, ILI9481_PASET);
-	ili9481_write_data(par, 0x00);
-	ili9481_write_data(par, 0x00);
-	ili9481_write_data(par, (par->height - 1) >> 8);
-	ili9481_write_data(par, (par->height - 1) & 0xFF);
-
-	/* Begin memory write and stream every pixel */
-	ili9481_write_cmd(par, ILI9481_RAMWR);
-
-	npixels = par->width * par->height;
-	for (i = 0; i < npixels; i++)
-		ili9481_write_pixel(par, vmem[i]);
+	struct fb_deferred_io_pageref *pageref;
+	u32 line_length = info->fix.line_length;
+	unsigned long flags;
+	u64 pages = 0;
+
+	spin_lock_irqsave(&par->damage_lock, flags);
+	list_for_each_entry(pageref, pagereflist, list) {
+		u32 start = pageref->offset / line_length;
+		u32 end = min_t(u32, (pageref->offset + PAGE_SIZE - 1) / line_length,
+				par->height - 1);
+
+		if (start < par->height)
+			bitmap_set(par->dirty_rows, start, end - start + 1);
+		pages++;
+	}
+	spin_unlock_irqrestore(&par->damage_lock, flags);
+
+	spin_lock_irqsave(&par->stats_lock, flags);
+	par->stats.defio_runs++;
+	par->stats.mmap_pages += pages;
+	spin_unlock_irqrestore(&par->stats_lock, flags);
+
+	if (par->worker) {
+		if (!kthread_queue_work(par->worker, &par->flush_work))
+			ili9481_stats_add(par, &par->stats.runs_merged, 1);
+	} else
+		ili9481_flush_pending(par);
 }
 
 /* ================================================================== */
 /* fb_ops wrappers — schedule deferred IO after every draw path       */
 /* ================================================================== */
 
+/*
+ * Grow the pending damage rectangle by (x, y, w, h), clipped to the
+ * screen, and schedule the flush.  fbcon may draw from atomic context,
+ * hence the irqsave lock.
+ */
+static void ili9481_damage(struct fb_info *info, u32 x, u32 y, u32 w, u32 h)
+{
+	struct ili9481_priv *par = info->par;
+	unsigned long flags;
+	u32 x1, y1;
+
+	if (!w || !h || x >= par->width || y >= par->height)
+		return;
+
+	x1 = min(x + w, par->width) - 1;
+	y1 = min(y + h, par->height) - 1;
+
+	spin_lock_irqsave(&par->damage_lock, flags);
+	if (par->damaged) {
+		par->dmg_x0 = min(par->dmg_x0, x);
+		par->dmg_y0 = min(par->dmg_y0, y);
+		par->dmg_x1 = max(par->dmg_x1, x1);
+		par->dmg_y1 = max(par->dmg_y1, y1);
+	} else {
+		par->dmg_x0 = x;
+		par->dmg_y0 = y;
+		par->dmg_x1 = x1;
+		par->dmg_y1 = y1;
+		par->damaged = true;
+	}
+	spin_unlock_irqrestore(&par->damage_lock, flags);
+
+	ili9481_stats_add(par, &par->stats.draws, 1);
+	if (!schedule_delayed_work(&info->deferred_work, info->fbdefio->delay))
+		ili9481_stats_add(par, &par->stats.draws_merged, 1);
+}
+
 static ssize_t ili9481_fb_write(struct fb_info *info,
 				const char __user *buf,
 				size_t count, loff_t *ppos)
 {
+	u32 line_length = info->fix.line_length;
+	loff_t pos = *ppos;
 	ssize_t ret = fb_sys_write(info, buf, count, ppos);
 
-	if (ret > 0)
-		schedule_delayed_work(&info->deferred_work,
-				      info->fbdefio->delay);
+	/* A linear write covers whole rows from the first to the last byte */
+	if (ret > 0) {
+		u32 y0 = div_u64(pos, line_length);
+		u32 y1 = div_u64(pos + ret - 1, line_length);
+
+		ili9481_damage(info, 0, y0, info->var.xres, y1 - y0 + 1);
+	}
 	return ret;
 }
 
@@ -186,21 +319,144 @@ static void ili9481_fb_fillrect(struct fb_info *info,
 				const struct fb_fillrect *rect)
 {
 	sys_fillrect(info, rect);
-	schedule_delayed_work(&info->deferred_work, info->fbdefio->delay);
+	ili9481_damage(info, rect->dx, rect->dy, rect->width, rect->height);
 }
 
 static void ili9481_fb_copyarea(struct fb_info *info,
 				const struct fb_copyarea *area)
 {
 	sys_copyarea(info, area);
-	schedule_delayed_work(&info->deferred_work, info->fbdefio->delay);
+	ili9481_damage(info, area->dx, area->dy, area->width, area->height);
 }
 
 static void ili9481_fb_imageblit(struct fb_info *info,
 				 const struct fb_image *image)
 {
 	sys_imageblit(info, image);
-	schedule_delayed_work(&info->deferred_work, info->fbdefio->delay);
+	ili9481_damage(info, image->dx, image->dy, image->width, image->height);
+}
+
+/* ================================================================== */
+/* Dedicated flush thread                                             */
+/* ================================================================== */
+
+/*
+ * With flush_thread=1, flushes run on a kthread_worker of their own at
+ * SCHED_FIFO priority, so a long bit-bang neither waits behind other
+ * system-workqueue items nor holds them up.  The optional "flush-cpu" DT
+ * property pins the worker to one CPU.
+ */
+static int ili9481_start_flush_thread(struct ili9481_priv *par)
+{
+	struct kthread_worker *worker;
+	u32 cpu;
+
+	kthread_init_work(&par->flush_work, ili9481_flush_work);
+	if (!flush_thread)
+		return 0;
+
+	worker = kthread_create_worker(0, "ili9481-flush");
+	if (IS_ERR(worker))
+		return PTR_ERR(worker);
+
+	sched_set_fifo(worker->task);
+
+	if (!of_property_read_u32(par->dev->of_node, "flush-cpu", &cpu)) {
+		if (cpu < nr_cpu_ids && cpu_online(cpu))
+			set_cpus_allowed_ptr(worker->task, cpumask_of(cpu));
+		else
+			dev_warn(par->dev, "flush-cpu %u is not online, ignored\n",
+				 cpu);
+	}
+
+	par->worker = worker;
+	dev_info(par->dev, "flushing on a dedicated SCHED_FIFO thread\n");
+	return 0;
+}
+
+static void ili9481_stop_flush_thread(struct ili9481_priv *par)
+{
+	if (par->worker)
+		kthread_destroy_worker(par->worker);
+	par->worker = NULL;
+}
+
+/* ================================================================== */
+/* debugfs statistics                                                 */
+/* ================================================================== */
+
+static int ili9481_stats_show(struct seq_file *m, void *unused)
+{
+	struct ili9481_priv *par = m->private;
+	struct ili9481_stats snap, *st = &snap;
+	unsigned long flags;
+	u64 flushes;
+	unsigned int b;
+
+	spin_lock_irqsave(&par->stats_lock, flags);
+	snap = par->stats;
+	spin_unlock_irqrestore(&par->stats_lock, flags);
+	flushes = st->flushes;
+
+	seq_printf(m, "flushes:      %llu\n", flushes);
+	seq_printf(m, "pixels:       %llu\n", st->pixels);
+	seq_printf(m, "defio_runs:   %llu\n", st->defio_runs);
+	seq_printf(m, "mmap_pages:   %llu\n", st->mmap_pages);
+	seq_printf(m, "runs_merged:  %llu\n", st->runs_merged);
+	seq_printf(m, "draws:        %llu\n", st->draws);
+	seq_printf(m, "draws_merged: %llu\n", st->draws_merged);
+	seq_printf(m, "flush_min_us: %llu\n",
+		   flushes ? div_u64(st->ns_min, NSEC_PER_USEC) : 0);
+	seq_printf(m, "flush_avg_us: %llu\n",
+		   flushes ? div64_u64(st->ns_total, flushes * NSEC_PER_USEC) : 0);
+	seq_printf(m, "flush_max_us: %llu\n",
+		   div_u64(st->ns_max, NSEC_PER_USEC));
+
+	seq_puts(m, "histogram:\n");
+	for (b = 0; b < ILI9481_HIST_BUCKETS - 1; b++)
+		seq_printf(m, "  < %7u us: %llu\n",
+			   ILI9481_HIST_BASE_US << b, st->hist[b]);
+	seq_printf(m, "  >=%7u us: %llu\n",
+		   ILI9481_HIST_BASE_US << (b - 1), st->hist[b]);
+	return 0;
+}
+
+static int ili9481_stats_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, ili9481_stats_show, inode->i_private);
+}
+
+/* Writing anything to "stats" zeroes the counters. */
+static ssize_t ili9481_stats_reset(struct file *file, const char __user *buf,
+				   size_t count, loff_t *ppos)
+{
+	struct ili9481_priv *par = file_inode(file)->i_private;
+	unsigned long flags;
+
+	spin_lock_irqsave(&par->stats_lock, flags);
+	memset(&par->stats, 0, sizeof(par->stats));
+	spin_unlock_irqrestore(&par->stats_lock, flags);
+	return count;
+}
+
+static const struct file_operations ili9481_stats_rw_fops = {
+	.owner   = THIS_MODULE,
+	.open    = ili9481_stats_open,
+	.read    = seq_read,
+	.llseek  = seq_lseek,
+	.release = single_release,
+	.write   = ili9481_stats_reset,
+};
+
+/* /sys/kernel/debug/ili9481-fbN/stats */
+static void ili9481_debugfs_init(struct ili9481_priv *par)
+{
+	char name[32];
+
+	snprintf(name, sizeof(name), "ili9481-fb%d", par->info->node);
+	par->debugfs = debugfs_create_dir(name, NULL);
+	debugfs_create_file("stats", 0644, par->debugfs, par,
+			    &ili9481_stats_rw_fops);
 }
 
 /* ================================================================== */
@@ -291,6 +547,8 @@ static int ili9481_probe(struct platform_device *pdev)
 	par       = info->par;
 	par->info = info;
 	par->dev  = dev;
+	spin_lock_init(&par->damage_lock);
+	spin_lock_init(&par->stats_lock);
 
 	/* ----- Device-tree properties ----- */
 	if (of_property_read_u32(dev->of_node, "rotate", &par->rotate))
@@ -311,39 +569,9 @@ static int ili9481_probe(struct platform_device *pdev)
 	}
 
 	/* ----- Acquire GPIOs ----- */
-	par->rst_gpio = devm_gpiod_get_optional(dev, "rst", GPIOD_OUT_LOW);
-	if (IS_ERR(par->rst_gpio)) {
-		ret = PTR_ERR(par->rst_gpio);
-		dev_err(dev, "rst GPIO: %d\n", ret);
-		goto err_fb;
-	}
-
-	par->dc_gpio = devm_gpiod_get(dev, "dc", GPIOD_OUT_LOW);
-	if (IS_ERR(par->dc_gpio)) {
-		ret = PTR_ERR(par->dc_gpio);
-		dev_err(dev, "dc GPIO: %d\n", ret);
+	ret = ili9481_bus_init(&par->bus, dev);
+	if (ret)
 		goto err_fb;
-	}
-
-	par->wr_gpio = devm_gpiod_get(dev, "wr", GPIOD_OUT_LOW);
-	if (IS_ERR(par->wr_gpio)) {
-		ret = PTR_ERR(par->wr_gpio);
-		dev_err(dev, "wr GPIO: %d\n", ret);
-		goto err_fb;
-	}
-
-	par->data_gpios = devm_gpiod_get_array(dev, "data", GPIOD_OUT_LOW);
-	if (IS_ERR(par->data_gpios)) {
-		ret = PTR_ERR(par->data_gpios);
-		dev_err(dev, "data GPIOs: %d\n", ret);
-		goto err_fb;
-	}
-	if (par->data_gpios->ndescs != 16) {
-		dev_err(dev, "need 16 data GPIOs, got %u\n",
-			par->data_gpios->ndescs);
-		ret = -EINVAL;
-		goto err_fb;
-	}
 
 	/* ----- Allocate video memory (vmalloc) ----- */
 	vmem_size = par->width * par->height * 2;	/* 16 bpp */
@@ -391,11 +619,17 @@ static int ili9481_probe(struct platform_device *pdev)
 		goto err_vmem;
 	}
 
+	ret = ili9481_start_flush_thread(par);
+	if (ret) {
+		dev_err(dev, "flush thread: %d\n", ret);
+		goto err_vmem;
+	}
+
 	/* ----- Deferred IO (automatic flush at fps interval) ----- */
 	defio = devm_kzalloc(dev, sizeof(*defio), GFP_KERNEL);
 	if (!defio) {
 		ret = -ENOMEM;
-		goto err_vmem;
+		goto err_thread;
 	}
 	defio->delay       = max(1UL, (unsigned long)(HZ / par->fps));
 	defio->deferred_io = ili9481_flush;
@@ -403,7 +637,7 @@ static int ili9481_probe(struct platform_device *pdev)
 	fb_deferred_io_init(info);
 
 	/* ----- Initialise the ILI9481 panel ----- */
-	ili9481_init_display(par);
+	ili9481_bus_init_display(&par->bus, par->rotate);
 
 	/* ----- Register the framebuffer ----- */
 	ret = register_framebuffer(info);
@@ -413,6 +647,7 @@ static int ili9481_probe(struct platform_device *pdev)
 	}
 
 	platform_set_drvdata(pdev, par);
+	ili9481_debugfs_init(par);
 	dev_info(dev,
 		 "ILI9481 %ux%u fb%d registered (rotate=%u, fps=%u)\n",
 		 par->width, par->height, info->node,
@@ -422,6 +657,8 @@ static int ili9481_probe(struct platform_device *pdev)
 
 err_defio:
 	fb_deferred_io_cleanup(info);
+err_thread:
+	ili9481_stop_flush_thread(par);
 err_vmem:
 	vfree(vmem);
 err_fb:
@@ -438,12 +675,13 @@ static void ili9481_remove(struct platform_device *pdev)
 	struct ili9481_priv *par = platform_get_drvdata(pdev);
 	struct fb_info *info = par->info;
 
+	debugfs_remove_recursive(par->debugfs);
 	unregister_framebuffer(info);
 	fb_deferred_io_cleanup(info);
+	ili9481_stop_flush_thread(par);	/* runs any queued flush first */
 
 	/* Power down the panel */
-	ili9481_write_cmd(par, ILI9481_DISPOFF);
-	ili9481_write_cmd(par, ILI9481_SLPIN);
+	ili9481_bus_power_off(&par->bus);
 
 	vfree(info->screen_buffer);
 	framebuffer_release(info);
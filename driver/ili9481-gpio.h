@@ -2,7 +2,7 @@
 /*
  * ili9481-gpio.h — ILI9481 register definitions and initialization table
  *
- * For use with the self-contained ili9481-gpio kernel framebuffer driver.
+ * Shared by the ili9481-bus, ili9481-gpio (fbdev) and ili9481-drm modules.
  */
 
 #ifndef ILI9481_GPIO_H
@@ -29,6 +29,8 @@
 #define ILI9481_PASET           0x2B
 #define ILI9481_RAMWR           0x2C
 #define ILI9481_MADCTL          0x36
+#define ILI9481_IDMOFF          0x38
+#define ILI9481_IDMON           0x39
 #define ILI9481_COLMOD          0x3A
 
 #define ILI9481_PWRSET          0xD0
@@ -43,6 +45,7 @@
 /* ------------------------------------------------------------------ */
 
 #define ILI9481_COLMOD_16BIT    0x55    /* 16-bit/pixel RGB565 */
+#define ILI9481_COLMOD_3BIT     0x11    /* 3-bit/pixel, 2 pixels per byte */
 
 /* ------------------------------------------------------------------ */
 /* MADCTL rotation values                                             */
@@ -243,6 +243,11 @@ if [ -f "$CMDLINE" ]; then
     CMDLINE_CONTENT="$CMDLINE_CONTENT video=HDMI-A-1:${RENDER_W}x${RENDER_H}@60D"
     echo "  Set video=HDMI-A-1:${RENDER_W}x${RENDER_H}@60D"
 
+    # Let fbcp send up to 64 KiB per SPI_IOC_MESSAGE (spidev default: 4 KiB)
+    CMDLINE_CONTENT=$(echo "$CMDLINE_CONTENT" | sed 's/ *spidev.bufsiz=[^ ]*//g')
+    CMDLINE_CONTENT="$CMDLINE_CONTENT spidev.bufsiz=65536"
+    echo "  Set spidev.bufsiz=65536"
+
     # Remove 'quiet' and 'splash' so boot messages are visible on TFT
     CMDLINE_CONTENT=$(echo "$CMDLINE_CONTENT" | sed 's/ quiet / /g; s/^quiet //; s/ quiet$//; s/ splash / /g; s/^splash //; s/ splash$//')
 
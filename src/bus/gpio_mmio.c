@@ -3,7 +3,9 @@
  * gpio_mmio.c — MMIO GPIO bus driver for ILI9481, 8-bit 8080-I mode
  *
  * Writes directly to BCM283x GPIO registers via /dev/gpiomem.
- * Uses a precomputed 256-entry lookup table for fast data bus writes.
+ * Uses a precomputed 256-entry lookup table for fast data bus writes;
+ * the /WR assertion is folded into the table's GPCLR0 word, so each byte
+ * costs three register stores and no barrier.
  *
  * Data bus:    DB0–DB7 (8 lines)
  * Control:     RST, CS, DC, WR, RD (5 lines)
@@ -41,8 +43,11 @@ struct gpio_bus {
     uint32_t           rst_mask;    /* 1 << GPIO_RST                    */
     uint32_t           cs_mask;     /* 1 << GPIO_CS                     */
     uint32_t           rd_mask;     /* 1 << GPIO_RD                     */
+    unsigned int       wr_hold;     /* extra /WR-low stores per byte     */
+    uint32_t           data_mask;   /* all DB0–DB7 bits                  */
 
-    /* Lookup table: 256-entry byte → GPSET0/GPCLR0 bit masks for DB0–DB7 */
+    /* Lookup table: 256-entry byte → GPSET0/GPCLR0 bit masks for DB0–DB7.
+       lut_clr also carries wr_mask, so one store drives /WR low too. */
     uint32_t lut_set[256];
     uint32_t lut_clr[256];
 };
@@ -133,20 +138,29 @@ static void gpio_set_output(volatile uint32_t *regs, int pin)
 /* LUT construction                                                   */
 /* ------------------------------------------------------------------ */
 
+/*
+ * Spread the 8 bits of `val` onto their DB0–DB7 GPIO positions.
+ * Branch-free and table-free: with db_pins[] constant, the compiler fully
+ * unrolls this into shifts and ORs, which vectorise across a pixel run.
+ */
+static inline uint32_t spread_byte(uint32_t val)
+{
+    uint32_t set = 0;
+    for (int bit = 0; bit < 8; bit++)
+        set |= ((val >> bit) & 1u) << db_pins[bit];
+    return set;
+}
+
 static void gpio_build_luts(struct gpio_bus *bus)
 {
     /* 256-entry LUT: for each byte value, precompute which GPIO bits to
-       SET and which to CLR so we can slam DB0–DB7 in one register write. */
+       SET and which to CLR so we can slam DB0–DB7 in one register write.
+       The CLR word also asserts /WR (active-low), see bus_write8(). */
+    bus->data_mask = spread_byte(0xFF);
     for (int val = 0; val < 256; val++) {
-        uint32_t set = 0, clr = 0;
-        for (int bit = 0; bit < 8; bit++) {
-            if (val & (1 << bit))
-                set |= (1u << db_pins[bit]);
-            else
-                clr |= (1u << db_pins[bit]);
-        }
+        uint32_t set = spread_byte((uint32_t)val);
         bus->lut_set[val] = set;
-        bus->lut_clr[val] = clr;
+        bus->lut_clr[val] = (set ^ bus->data_mask) | bus->wr_mask;
     }
 }
 
@@ -158,19 +172,31 @@ static void gpio_build_luts(struct gpio_bus *bus)
  * Write an 8-bit value onto the data bus (DB0–DB7) and pulse /WR.
  *
  * 8080-I timing:
- *   1.  Place data on bus (SET/CLR in one shot via LUT)
- *   2.  Assert /WR low  (active-low: CLR the WR pin)
- *   3.  DMB barrier (≥ 15 ns on BCM283x)
+ *   1.  Drive the data 1-bits (GPSET0)
+ *   2.  Drive the data 0-bits AND assert /WR low in the same GPCLR0 store
+ *   3.  Optionally repeat the /WR-low store `wr_hold` times to stretch tWRL
  *   4.  Release /WR high (rising edge latches data into controller)
+ *
+ * The controller samples DB0–DB7 on the rising edge of /WR, so data only
+ * has to be stable by step 4; asserting /WR together with the 0-bits does
+ * not violate setup time.
+ *
+ * No DMB is needed between the stores: /dev/gpiomem is mapped as Device
+ * memory, and the ARM memory model keeps Device accesses to the same
+ * peripheral in program order.  The volatile register pointer already
+ * stops the compiler from merging or reordering them.  Each store takes
+ * roughly one GPIO bus cycle to land, which also bounds the pulse width.
  */
 static inline void __attribute__((optimize("O3")))
 bus_write8(struct gpio_bus *bus, uint8_t val)
 {
-    bus->regs[GPSET0] = bus->lut_set[val];
-    bus->regs[GPCLR0] = bus->lut_clr[val];
-    bus->regs[GPCLR0] = bus->wr_mask;
-    dmb();
-    bus->regs[GPSET0] = bus->wr_mask;
+    volatile uint32_t *regs = bus->regs;
+
+    regs[GPSET0] = bus->lut_set[val];
+    regs[GPCLR0] = bus->lut_clr[val];
+    for (unsigned int i = 0; i < bus->wr_hold; i++)
+        regs[GPCLR0] = bus->wr_mask;
+    regs[GPSET0] = bus->wr_mask;
 }
 
 /* ------------------------------------------------------------------ */
@@ -255,6 +281,19 @@ void gpio_bus_close(struct gpio_bus *bus)
     free(bus);
 }
 
+void gpio_bus_set_wr_hold(struct gpio_bus *bus, unsigned int cycles)
+{
+    if (!bus)
+        return;
+
+    if (cycles > GPIO_WR_HOLD_MAX)
+        cycles = GPIO_WR_HOLD_MAX;
+    bus->wr_hold = cycles;
+
+    log_info("GPIO bus: /WR hold = %u extra bus cycle%s (%u stores/byte)",
+             cycles, cycles == 1 ? "" : "s", 3 + cycles);
+}
+
 void gpio_hw_reset(struct gpio_bus *bus)
 {
     if (!bus)
@@ -303,6 +342,47 @@ gpio_write_pixels(struct gpio_bus *bus, const uint16_t *pixels, uint32_t count)
     }
 }
 
+void __attribute__((optimize("O3")))
+gpio_expand_pixels(const struct gpio_bus *bus, const uint16_t *pixels,
+                   uint32_t count, struct gpio_word *words)
+{
+    const uint32_t data_mask = bus->data_mask;
+    const uint32_t wr_mask = bus->wr_mask;
+
+    /* Same byte order as gpio_write_pixels(): high byte first */
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t px = pixels[i];
+        uint32_t hi = spread_byte(px >> 8);
+        uint32_t lo = spread_byte(px & 0xFF);
+
+        words[2 * i].set     = hi;
+        words[2 * i].clr     = (hi ^ data_mask) | wr_mask;
+        words[2 * i + 1].set = lo;
+        words[2 * i + 1].clr = (lo ^ data_mask) | wr_mask;
+    }
+}
+
+void __attribute__((optimize("O3")))
+gpio_write_words(struct gpio_bus *bus, const struct gpio_word *words, uint32_t count)
+{
+    /*
+     * Same strobe sequence as bus_write8(), but the register words are
+     * read sequentially from memory — no data-dependent table lookups in
+     * the timing-critical loop.
+     */
+    volatile uint32_t *regs = bus->regs;
+    const uint32_t wr_mask = bus->wr_mask;
+    const unsigned int wr_hold = bus->wr_hold;
+
+    for (uint32_t i = 0; i < count; i++) {
+        regs[GPSET0] = words[i].set;
+        regs[GPCLR0] = words[i].clr;
+        for (unsigned int h = 0; h < wr_hold; h++)
+            regs[GPCLR0] = wr_mask;
+        regs[GPSET0] = wr_mask;
+    }
+}
+
 /* ------------------------------------------------------------------ */
 /* Diagnostic: toggle each GPIO pin one-by-one for multimeter probing */
 /* ------------------------------------------------------------------ */
@@ -13,6 +13,15 @@
 /* Forward declaration */
 struct gpio_bus;
 
+/*
+ * One precomputed bus cycle: the GPSET0 word (data 1-bits) and the GPCLR0
+ * word (data 0-bits + /WR assert), ready to be stored as-is.
+ */
+struct gpio_word {
+    uint32_t set;
+    uint32_t clr;
+};
+
 /*
  * gpio_bus_open() — Detect Pi model, open /dev/gpiomem, mmap GPIO registers,
  *                   set 13 pins to output (8 data + 5 control), build LUT.
@@ -26,6 +35,19 @@ struct gpio_bus *gpio_bus_open(void);
  */
 void gpio_bus_close(struct gpio_bus *bus);
 
+/* Upper bound accepted by gpio_bus_set_wr_hold() */
+#define GPIO_WR_HOLD_MAX    16
+
+/*
+ * gpio_bus_set_wr_hold() — Stretch the /WR low pulse by `cycles` extra
+ *                          register stores per byte (default 0).
+ *
+ * Each extra store adds roughly one GPIO bus cycle.  Raise this for
+ * level-shifter boards that drop bytes at full speed.  Clamped to
+ * GPIO_WR_HOLD_MAX.
+ */
+void gpio_bus_set_wr_hold(struct gpio_bus *bus, unsigned int cycles);
+
 /*
  * gpio_hw_reset() — Assert /RST low for 20 ms, release, wait 120 ms.
  */
@@ -47,6 +69,23 @@ void gpio_write_data(struct gpio_bus *bus, uint8_t data);
  */
 void gpio_write_pixels(struct gpio_bus *bus, const uint16_t *pixels, uint32_t count);
 
+/*
+ * gpio_expand_pixels() — Convert `count` RGB565 pixels into `2 * count`
+ *                        ready-to-store bus words (high byte first).
+ *
+ * Touches no registers, so it may run on a different thread/core than the
+ * bus writer.  `words` must hold at least `2 * count` entries.
+ */
+void gpio_expand_pixels(const struct gpio_bus *bus, const uint16_t *pixels,
+                        uint32_t count, struct gpio_word *words);
+
+/*
+ * gpio_write_words() — Stream `count` words produced by gpio_expand_pixels().
+ *                       DC must already be high (data mode).
+ */
+void gpio_write_words(struct gpio_bus *bus, const struct gpio_word *words,
+                      uint32_t count);
+
 /*
  * gpio_bus_probe() — Toggle each configured GPIO pin one-by-one (3 seconds
  *                    each), printing the pin name.  For board-level debugging
@@ -20,10 +20,16 @@ void config_defaults(struct ili9481_config *cfg)
     memset(cfg, 0, sizeof(*cfg));
     cfg->rotation     = 270;
     cfg->fps          = 30;
+    cfg->idle_fps     = 5;
+    cfg->idle_after   = 60;
     strncpy(cfg->fb_device, "/dev/fb0", sizeof(cfg->fb_device) - 1);
     cfg->enable_touch = 0;
     strncpy(cfg->spi_device, "/dev/spidev0.1", sizeof(cfg->spi_device) - 1);
     cfg->spi_speed    = 2000000;
+    cfg->wr_hold      = 0;
+    cfg->stream_mode  = 0;
+    cfg->pipeline     = 1;
+    cfg->scale_filter = 0;
     cfg->benchmark    = 0;
     cfg->test_pattern = 0;
     cfg->gpio_probe   = 0;
@@ -41,6 +47,11 @@ static char *strip(char *s)
     return s;
 }
 
+static int parse_filter(const char *val)
+{
+    return strcmp(val, "box") == 0 || strcmp(val, "area") == 0;
+}
+
 static void apply_kv(struct ili9481_config *cfg, const char *key, const char *val)
 {
     if (strcmp(key, "rotation") == 0 || strcmp(key, "rotate") == 0) {
@@ -49,6 +60,11 @@ static void apply_kv(struct ili9481_config *cfg, const char *key, const char *va
         cfg->fps = atoi(val);
         if (cfg->fps < 1) cfg->fps = 1;
         if (cfg->fps > 60) cfg->fps = 60;
+    } else if (strcmp(key, "idle_fps") == 0) {
+        cfg->idle_fps = atoi(val);
+        if (cfg->idle_fps < 1) cfg->idle_fps = 1;
+    } else if (strcmp(key, "idle_after") == 0) {
+        cfg->idle_after = (uint32_t)atoi(val);
     } else if (strcmp(key, "fb_device") == 0) {
         strncpy(cfg->fb_device, val, sizeof(cfg->fb_device) - 1);
     } else if (strcmp(key, "enable_touch") == 0) {
@@ -57,6 +73,14 @@ static void apply_kv(struct ili9481_config *cfg, const char *key, const char *va
         strncpy(cfg->spi_device, val, sizeof(cfg->spi_device) - 1);
     } else if (strcmp(key, "spi_speed") == 0) {
         cfg->spi_speed = (uint32_t)atoi(val);
+    } else if (strcmp(key, "wr_hold") == 0) {
+        cfg->wr_hold = (uint32_t)atoi(val);
+    } else if (strcmp(key, "stream_mode") == 0) {
+        cfg->stream_mode = atoi(val);
+    } else if (strcmp(key, "pipeline") == 0) {
+        cfg->pipeline = atoi(val);
+    } else if (strcmp(key, "scale_filter") == 0) {
+        cfg->scale_filter = parse_filter(val);
     }
     /* Unknown keys are silently ignored */
 }
@@ -126,8 +150,25 @@ int config_parse_args(struct ili9481_config *cfg, int argc, char **argv)
             cfg->fps = atoi(argv[i] + 6);
             if (cfg->fps < 1) cfg->fps = 1;
             if (cfg->fps > 60) cfg->fps = 60;
+        } else if (strncmp(argv[i], "--idle-fps=", 11) == 0) {
+            cfg->idle_fps = atoi(argv[i] + 11);
+            if (cfg->idle_fps < 1) cfg->idle_fps = 1;
+        } else if (strncmp(argv[i], "--idle-after=", 13) == 0) {
+            cfg->idle_after = (uint32_t)atoi(argv[i] + 13);
         } else if (strncmp(argv[i], "--fb=", 5) == 0) {
             strncpy(cfg->fb_device, argv[i] + 5, sizeof(cfg->fb_device) - 1);
+        } else if (strncmp(argv[i], "--wr-hold=", 10) == 0) {
+            cfg->wr_hold = (uint32_t)atoi(argv[i] + 10);
+        } else if (strcmp(argv[i], "--stream") == 0) {
+            cfg->stream_mode = 1;
+        } else if (strcmp(argv[i], "--no-stream") == 0) {
+            cfg->stream_mode = 0;
+        } else if (strcmp(argv[i], "--pipeline") == 0) {
+            cfg->pipeline = 1;
+        } else if (strcmp(argv[i], "--no-pipeline") == 0) {
+            cfg->pipeline = 0;
+        } else if (strncmp(argv[i], "--scale-filter=", 15) == 0) {
+            cfg->scale_filter = parse_filter(argv[i] + 15);
         } else if (strcmp(argv[i], "--touch") == 0) {
             cfg->enable_touch = 1;
         } else if (strcmp(argv[i], "--no-touch") == 0) {
@@ -143,7 +184,15 @@ int config_parse_args(struct ili9481_config *cfg, int argc, char **argv)
                    "  --config=PATH    Config file path\n"
                    "  --rotate=DEG     Rotation: 0, 90, 180, 270 (default: 270)\n"
                    "  --fps=N          Target FPS (default: 30)\n"
+                   "  --idle-fps=N     Poll rate after idle-after quiet frames (default: 5)\n"
+                   "  --idle-after=N   Quiet frames before idling, 0 = never (default: 60)\n"
                    "  --fb=DEVICE      Source framebuffer to mirror (default: /dev/fb0)\n"
+                   "  --wr-hold=N      Extra /WR-low bus cycles per byte (default: 0)\n"
+                   "  --stream         Pre-expand pixels into GPIO words before flushing\n"
+                   "  --no-stream      Look up GPIO words per byte while flushing (default)\n"
+                   "  --pipeline       Scale on a second core while flushing (default)\n"
+                   "  --no-pipeline    Scale and flush on one thread\n"
+                   "  --scale-filter=F nearest (default) or box (area average)\n"
                    "  --touch          Enable touch support\n"
                    "  --no-touch       Disable touch support (default)\n"
                    "  --benchmark      Run FPS benchmark and exit\n"
@@ -169,7 +218,13 @@ void config_dump(const struct ili9481_config *cfg)
     log_info("Configuration:");
     log_info("  rotation    = %u", cfg->rotation);
     log_info("  fps         = %d", cfg->fps);
+    log_info("  idle        = %d FPS after %u quiet frames", cfg->idle_fps,
+             cfg->idle_after);
     log_info("  fb_device   = %s", cfg->fb_device);
+    log_info("  wr_hold     = %u", cfg->wr_hold);
+    log_info("  stream_mode = %s", cfg->stream_mode ? "on" : "off");
+    log_info("  pipeline    = %s", cfg->pipeline ? "on" : "off");
+    log_info("  filter      = %s", cfg->scale_filter ? "box" : "nearest");
     log_info("  touch       = %s", cfg->enable_touch ? "enabled" : "disabled");
     if (cfg->enable_touch) {
         log_info("  spi_device  = %s", cfg->spi_device);
@@ -15,10 +15,16 @@
 struct ili9481_config {
     uint32_t    rotation;       /* 0, 90, 180, 270             */
     int         fps;            /* Target refresh rate          */
+    int         idle_fps;       /* Poll rate once idle          */
+    uint32_t    idle_after;     /* Quiet frames before idling   */
     char        fb_device[64];  /* Framebuffer device path      */
     int         enable_touch;   /* 0 = disabled, 1 = enabled   */
     char        spi_device[64]; /* SPI device for touch         */
     uint32_t    spi_speed;      /* SPI clock in Hz              */
+    uint32_t    wr_hold;        /* Extra /WR-low bus cycles     */
+    int         stream_mode;    /* 1 = pre-expand bus words     */
+    int         pipeline;       /* 1 = scale on second core     */
+    int         scale_filter;   /* 0 = nearest, 1 = box         */
     int         benchmark;      /* 1 = benchmark mode           */
     int         test_pattern;   /* 1 = solid colour test        */
     int         gpio_probe;     /* 1 = toggle pins one by one   */
@@ -44,7 +50,13 @@ int config_load(struct ili9481_config *cfg, const char *path);
  *   --config=PATH
  *   --rotate=DEG
  *   --fps=N
+ *   --idle-fps=N
+ *   --idle-after=N
  *   --fb=DEVICE
+ *   --wr-hold=N
+ *   --stream / --no-stream
+ *   --pipeline / --no-pipeline
+ *   --scale-filter=nearest|box
  *   --touch / --no-touch
  *   --benchmark
  *
@@ -0,0 +1,107 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * pacer.c — Adaptive frame pacing (target rate ↔ idle rate)
+ *
+ * The sleep is a pthread_cond_timedwait() on CLOCK_MONOTONIC with an
+ * absolute deadline, so ticks do not drift and a kick from another
+ * thread ends the sleep immediately.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#include "pacer.h"
+
+static void timespec_add(struct timespec *ts, long ns)
+{
+    ts->tv_nsec += ns;
+    while (ts->tv_nsec >= 1000000000L) {
+        ts->tv_nsec -= 1000000000L;
+        ts->tv_sec++;
+    }
+}
+
+int pacer_init(struct pacer *p)
+{
+    pthread_condattr_t attr;
+
+    memset(p, 0, sizeof(*p));
+
+    if (pthread_condattr_init(&attr) != 0)
+        return -1;
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    int rc = pthread_cond_init(&p->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    if (rc != 0)
+        return -1;
+
+    if (pthread_mutex_init(&p->lock, NULL) != 0) {
+        pthread_cond_destroy(&p->cond);
+        return -1;
+    }
+    return 0;
+}
+
+void pacer_start(struct pacer *p, int fps, int idle_fps, unsigned int idle_after)
+{
+    pthread_mutex_lock(&p->lock);
+    p->active_ns  = 1000000000L / fps;
+    p->idle_ns    = idle_fps > 0 ? 1000000000L / idle_fps : p->active_ns;
+    p->idle_after = p->idle_ns > p->active_ns ? idle_after : 0;
+    p->quiet      = 0;
+    p->kicked     = 0;
+    clock_gettime(CLOCK_MONOTONIC, &p->next);
+    pthread_mutex_unlock(&p->lock);
+}
+
+void pacer_wait(struct pacer *p)
+{
+    pthread_mutex_lock(&p->lock);
+    while (!p->kicked) {
+        if (pthread_cond_timedwait(&p->cond, &p->lock, &p->next) == ETIMEDOUT)
+            break;
+    }
+    if (p->kicked) {
+        /* Restart the tick grid from now at the target rate */
+        p->kicked = 0;
+        p->quiet  = 0;
+        clock_gettime(CLOCK_MONOTONIC, &p->next);
+    }
+    pthread_mutex_unlock(&p->lock);
+}
+
+int pacer_frame(struct pacer *p, int damaged)
+{
+    int idle;
+
+    pthread_mutex_lock(&p->lock);
+    if (damaged)
+        p->quiet = 0;
+    else if (p->quiet < p->idle_after)
+        p->quiet++;
+
+    idle = p->idle_after && p->quiet >= p->idle_after;
+    timespec_add(&p->next, idle ? p->idle_ns : p->active_ns);
+    pthread_mutex_unlock(&p->lock);
+
+    return idle;
+}
+
+void pacer_kick(struct pacer *p)
+{
+    pthread_mutex_lock(&p->lock);
+    if (p->idle_after && p->quiet >= p->idle_after) {
+        p->kicked = 1;
+        pthread_cond_signal(&p->cond);
+    }
+    p->quiet = 0;
+    pthread_mutex_unlock(&p->lock);
+}
+
+void pacer_destroy(struct pacer *p)
+{
+    pthread_cond_destroy(&p->cond);
+    pthread_mutex_destroy(&p->lock);
+}
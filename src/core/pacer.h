@@ -0,0 +1,71 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * pacer.h — Adaptive frame pacing for the mirror loops
+ *
+ * Ticks at the configured rate while the source is changing.  After
+ * `idle_after` consecutive frames without damage it drops to `idle_fps`,
+ * and returns to the full rate on the first damaged frame — or at once,
+ * mid-sleep, when another thread (touch input) calls pacer_kick().
+ */
+
+#ifndef PACER_H
+#define PACER_H
+
+#include <pthread.h>
+#include <time.h>
+
+struct pacer {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;           /* signalled by pacer_kick()        */
+    int             kicked;
+
+    long            active_ns;      /* tick period at the target rate   */
+    long            idle_ns;        /* tick period once idle            */
+    unsigned int    idle_after;     /* 0 = never back off               */
+    unsigned int    quiet;          /* consecutive frames without damage */
+    struct timespec next;           /* next tick (CLOCK_MONOTONIC)      */
+};
+
+/*
+ * pacer_init() — Initialise the lock and condition variable.
+ *
+ * pacer_kick() may be used from then on; call pacer_start() before the
+ * first pacer_wait().  Returns 0 on success, -1 on error.
+ */
+int pacer_init(struct pacer *p);
+
+/*
+ * pacer_start() — Tick at `fps`, falling back to `idle_fps` after
+ *                 `idle_after` undamaged frames.
+ *
+ * `idle_after` = 0 or `idle_fps` >= `fps` disables the back-off.
+ * The first tick is due immediately.
+ */
+void pacer_start(struct pacer *p, int fps, int idle_fps, unsigned int idle_after);
+
+/*
+ * pacer_wait() — Sleep until the next tick is due or pacer_kick() is
+ *                called, whichever comes first.
+ */
+void pacer_wait(struct pacer *p);
+
+/*
+ * pacer_frame() — Report whether the frame just processed had damage and
+ *                 schedule the next tick accordingly.
+ *
+ * Returns 1 while in idle (slow) mode, 0 at the target rate.
+ */
+int pacer_frame(struct pacer *p, int damaged);
+
+/*
+ * pacer_kick() — Wake the loop now and return it to the target rate.
+ *                Safe to call from any thread.
+ */
+void pacer_kick(struct pacer *p);
+
+/*
+ * pacer_destroy() — Release the mutex and condition variable.
+ */
+void pacer_destroy(struct pacer *p);
+
+#endif /* PACER_H */
@@ -161,6 +161,7 @@ static void run_test_pattern(struct gpio_bus *bus, uint16_t w, uint16_t h)
 
 struct touch_thread_args {
     const struct ili9481_config *cfg;
+    struct fb_provider *fb;
     uint16_t width;
     uint16_t height;
     volatile int *running;
@@ -214,6 +215,9 @@ static void *touch_thread_fn(void *arg)
             pen_up_count = 0;
             was_down = 1;
             uinput_touch_report(ut, 1, x, y);
+
+            /* The UI is about to react: get the mirror back to full rate */
+            fb_provider_kick(ta->fb);
         } else {
             if (was_down) {
                 pen_up_count++;
@@ -278,6 +282,7 @@ int main(int argc, char **argv)
         log_error("Failed to open GPIO bus after retries — aborting");
         goto out;
     }
+    gpio_bus_set_wr_hold(bus, cfg.wr_hold);
 
     /* Initialise the ILI9481 display panel */
     ili9481_init(bus, cfg.rotation);
@@ -322,6 +327,11 @@ int main(int argc, char **argv)
         log_error("Failed to initialise framebuffer after retries — aborting");
         goto out;
     }
+    fb_provider_set_stream(fb, cfg.stream_mode);
+    fb_provider_set_pipeline(fb, cfg.pipeline);
+    fb_provider_set_filter(fb, cfg.scale_filter ? SCALE_FILTER_BOX
+                                                : SCALE_FILTER_NEAREST);
+    fb_provider_set_idle(fb, cfg.idle_fps, cfg.idle_after);
 
     /* Install signal handlers for clean shutdown */
     install_signal_handlers();
@@ -333,6 +343,7 @@ int main(int argc, char **argv)
 
     if (cfg.enable_touch) {
         ta.cfg = &cfg;
+        ta.fb = fb;
         ta.width = disp_w;
         ta.height = disp_h;
         ta.running = &g_running;
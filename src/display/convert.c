@@ -0,0 +1,130 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * convert.c — SIMD 32bpp → RGB565 row conversion with indexed column gather
+ *
+ * Eight destination pixels are handled per iteration: the eight source
+ * pixels are gathered through `xmap` into a small aligned block (SIMD has
+ * no cheap gather on these cores), then shifted, masked and narrowed to
+ * RGB565 in vector registers.
+ *
+ *   NEON  — ARMv7 with NEON, AArch64 (Pi 2/3/4/Zero 2 W)
+ *   SSE2  — x86-64 (build/test hosts)
+ *   plain — everything else, and the < 8 pixel tail
+ */
+
+#include <stdint.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CONVERT_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define CONVERT_SSE2 1
+#endif
+
+#include "convert.h"
+
+/* ------------------------------------------------------------------ */
+/* Layout                                                             */
+/* ------------------------------------------------------------------ */
+
+int convert_layout_init(struct convert_layout *layout,
+                        uint32_t r_off, uint32_t r_len,
+                        uint32_t g_off, uint32_t g_len,
+                        uint32_t b_off, uint32_t b_len)
+{
+    if (r_len != 8 || g_len != 8 || b_len != 8)
+        return -1;
+    if (r_off > 24 || g_off > 24 || b_off > 24)
+        return -1;
+
+    layout->r_shift = r_off + 3;
+    layout->g_shift = g_off + 2;
+    layout->b_shift = b_off + 3;
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Scalar reference                                                   */
+/* ------------------------------------------------------------------ */
+
+static inline uint16_t pack565(uint32_t px, const struct convert_layout *l)
+{
+    return (uint16_t)((((px >> l->r_shift) & 0x1F) << 11) |
+                      (((px >> l->g_shift) & 0x3F) << 5)  |
+                       ((px >> l->b_shift) & 0x1F));
+}
+
+/* ------------------------------------------------------------------ */
+/* Row kernels                                                        */
+/* ------------------------------------------------------------------ */
+
+void __attribute__((optimize("O3")))
+convert_row_32(uint16_t *dst, const uint32_t *src, const uint32_t *xmap,
+               uint32_t count, const struct convert_layout *layout)
+{
+    uint32_t i = 0;
+
+#if defined(CONVERT_NEON)
+    /* vshlq_u32 with a negative count is a per-lane logical right shift */
+    const int32x4_t rs = vdupq_n_s32(-(int32_t)layout->r_shift);
+    const int32x4_t gs = vdupq_n_s32(-(int32_t)layout->g_shift);
+    const int32x4_t bs = vdupq_n_s32(-(int32_t)layout->b_shift);
+    const uint32x4_t m5 = vdupq_n_u32(0x1F);
+    const uint32x4_t m6 = vdupq_n_u32(0x3F);
+    uint32_t blk[8] __attribute__((aligned(16)));
+
+    for (; i + 8 <= count; i += 8) {
+        for (int k = 0; k < 8; k++)
+            blk[k] = src[xmap[i + k]];
+
+        uint16x4_t half[2];
+        for (int h = 0; h < 2; h++) {
+            uint32x4_t px = vld1q_u32(&blk[h * 4]);
+            uint32x4_t r = vandq_u32(vshlq_u32(px, rs), m5);
+            uint32x4_t g = vandq_u32(vshlq_u32(px, gs), m6);
+            uint32x4_t b = vandq_u32(vshlq_u32(px, bs), m5);
+            uint32x4_t v = vorrq_u32(vorrq_u32(vshlq_n_u32(r, 11),
+                                               vshlq_n_u32(g, 5)), b);
+            half[h] = vmovn_u32(v);
+        }
+        vst1q_u16(&dst[i], vcombine_u16(half[0], half[1]));
+    }
+#elif defined(CONVERT_SSE2)
+    const __m128i rs = _mm_cvtsi32_si128((int)layout->r_shift);
+    const __m128i gs = _mm_cvtsi32_si128((int)layout->g_shift);
+    const __m128i bs = _mm_cvtsi32_si128((int)layout->b_shift);
+    const __m128i m5 = _mm_set1_epi32(0x1F);
+    const __m128i m6 = _mm_set1_epi32(0x3F);
+    uint32_t blk[8] __attribute__((aligned(16)));
+
+    for (; i + 8 <= count; i += 8) {
+        for (int k = 0; k < 8; k++)
+            blk[k] = src[xmap[i + k]];
+
+        __m128i half[2];
+        for (int h = 0; h < 2; h++) {
+            __m128i px = _mm_load_si128((const __m128i *)&blk[h * 4]);
+            __m128i r = _mm_and_si128(_mm_srl_epi32(px, rs), m5);
+            __m128i g = _mm_and_si128(_mm_srl_epi32(px, gs), m6);
+            __m128i b = _mm_and_si128(_mm_srl_epi32(px, bs), m5);
+            __m128i v = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, 11),
+                                                  _mm_slli_epi32(g, 5)), b);
+            /* Sign-extend the low 16 bits so the signed pack is exact */
+            half[h] = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+        }
+        _mm_storeu_si128((__m128i *)&dst[i], _mm_packs_epi32(half[0], half[1]));
+    }
+#endif
+
+    for (; i < count; i++)
+        dst[i] = pack565(src[xmap[i]], layout);
+}
+
+void __attribute__((optimize("O3")))
+convert_row_16(uint16_t *dst, const uint16_t *src, const uint32_t *xmap,
+               uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        dst[i] = src[xmap[i]];
+}
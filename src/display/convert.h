@@ -0,0 +1,50 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * convert.h — Row kernels: gather source columns + convert to RGB565
+ *
+ * Used by the scaler to produce one destination row at a time.  The
+ * column gather uses a precomputed source-index table (`xmap`), so there
+ * is no per-pixel divide; the 32bpp → RGB565 packing runs on NEON (ARM),
+ * SSE2 (x86) or a portable scalar loop.
+ */
+
+#ifndef CONVERT_H
+#define CONVERT_H
+
+#include <stdint.h>
+
+/*
+ * Right-shift amounts that bring the top bits of each 8-bit channel of a
+ * 32bpp pixel down to bit 0.  Describes XRGB8888, ARGB8888, XBGR8888,
+ * BGRX8888 and any other layout with 8-bit channels.
+ */
+struct convert_layout {
+    uint32_t r_shift;   /* red offset   + 3 (8 → 5 bits) */
+    uint32_t g_shift;   /* green offset + 2 (8 → 6 bits) */
+    uint32_t b_shift;   /* blue offset  + 3 (8 → 5 bits) */
+};
+
+/*
+ * convert_layout_init() — Fill `layout` from fb_var_screeninfo bit fields.
+ *
+ * Returns 0 if the source has 8-bit red/green/blue channels (fast path
+ * available), -1 otherwise (caller must use a generic per-pixel path).
+ */
+int convert_layout_init(struct convert_layout *layout,
+                        uint32_t r_off, uint32_t r_len,
+                        uint32_t g_off, uint32_t g_len,
+                        uint32_t b_off, uint32_t b_len);
+
+/*
+ * convert_row_32() — dst[i] = RGB565(src[xmap[i]]) for i in [0, count).
+ */
+void convert_row_32(uint16_t *dst, const uint32_t *src, const uint32_t *xmap,
+                    uint32_t count, const struct convert_layout *layout);
+
+/*
+ * convert_row_16() — dst[i] = src[xmap[i]] for an RGB565 source.
+ */
+void convert_row_16(uint16_t *dst, const uint16_t *src, const uint32_t *xmap,
+                    uint32_t count);
+
+#endif /* CONVERT_H */
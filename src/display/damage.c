@@ -0,0 +1,197 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * damage.c — Row-span damage tracking between consecutive frames
+ *
+ * Each row is first checked with memcmp() (fast path for the common case of
+ * an unchanged row), then scanned from both ends to find the first and last
+ * changed pixel.  Vertically adjacent changed rows are grouped into one
+ * rectangle covering the union of their column spans.
+ *
+ * damage_diff_band() works one band of cells at a time instead and trades
+ * clean pixels against window setup cost, for the SPI panels where each
+ * CASET/PASET/RAMWR is several ioctls and bands go out as they are ready.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "damage.h"
+
+/* ------------------------------------------------------------------ */
+/* Helpers                                                            */
+/* ------------------------------------------------------------------ */
+
+static void rect_union(struct damage_rect *dst, const struct damage_rect *r)
+{
+    uint16_t x0 = dst->x < r->x ? dst->x : r->x;
+    uint16_t y0 = dst->y < r->y ? dst->y : r->y;
+    uint16_t x1 = (dst->x + dst->w > r->x + r->w) ? dst->x + dst->w : r->x + r->w;
+    uint16_t y1 = (dst->y + dst->h > r->y + r->h) ? dst->y + dst->h : r->y + r->h;
+
+    dst->x = x0;
+    dst->y = y0;
+    dst->w = x1 - x0;
+    dst->h = y1 - y0;
+}
+
+static void rect_push(struct damage_rect *rects, int *count, int max_rects,
+                      const struct damage_rect *r)
+{
+    if (*count < max_rects)
+        rects[(*count)++] = *r;
+    else
+        rect_union(&rects[max_rects - 1], r);
+}
+
+/* Bitmask of dirty cells in the band of `h` rows starting at `y0` */
+static uint64_t band_mask(const uint16_t *cur, const uint16_t *prev,
+                          uint16_t width, uint16_t y0, uint16_t h,
+                          uint16_t cell, int cols, const uint8_t *rows)
+{
+    uint64_t all = cols == 64 ? ~0ULL : (1ULL << cols) - 1;
+    uint64_t mask = 0;
+
+    for (uint16_t y = y0; y < y0 + h && mask != all; y++) {
+        const uint16_t *cr = cur + (uint32_t)y * width;
+        const uint16_t *pr = prev + (uint32_t)y * width;
+
+        if (rows && !rows[y])
+            continue;
+        if (memcmp(cr, pr, (size_t)width * sizeof(uint16_t)) == 0)
+            continue;
+
+        for (int c = 0; c < cols; c++) {
+            uint16_t x = (uint16_t)(c * cell);
+            uint16_t w = width - x < cell ? width - x : cell;
+
+            if (!(mask & (1ULL << c)) &&
+                memcmp(cr + x, pr + x, (size_t)w * sizeof(uint16_t)) != 0)
+                mask |= 1ULL << c;
+        }
+    }
+    return mask;
+}
+
+/* ------------------------------------------------------------------ */
+/* Public API                                                         */
+/* ------------------------------------------------------------------ */
+
+int damage_diff(const uint16_t *cur, const uint16_t *prev,
+                uint16_t width, uint16_t height,
+                struct damage_rect *rects, int max_rects)
+{
+    struct damage_rect open = { 0, 0, 0, 0 };
+    int count = 0;
+
+    if (max_rects <= 0)
+        return 0;
+
+    for (uint16_t y = 0; y < height; y++) {
+        const uint16_t *cr = cur + (uint32_t)y * width;
+        const uint16_t *pr = prev + (uint32_t)y * width;
+
+        if (memcmp(cr, pr, (size_t)width * sizeof(uint16_t)) == 0) {
+            /* Clean row terminates the current run */
+            if (open.h) {
+                rect_push(rects, &count, max_rects, &open);
+                open.h = 0;
+            }
+            continue;
+        }
+
+        uint16_t x0 = 0;
+        while (cr[x0] == pr[x0])
+            x0++;
+        uint16_t x1 = width - 1;
+        while (cr[x1] == pr[x1])
+            x1--;
+
+        struct damage_rect row = { x0, y, (uint16_t)(x1 - x0 + 1), 1 };
+        if (open.h)
+            rect_union(&open, &row);
+        else
+            open = row;
+    }
+
+    if (open.h)
+        rect_push(rects, &count, max_rects, &open);
+
+    return count;
+}
+
+int damage_diff_band(const uint16_t *cur, const uint16_t *prev,
+                     uint16_t width, uint16_t height, uint16_t y0,
+                     uint16_t tile, const uint8_t *rows, uint32_t window_cost,
+                     const struct damage_rect *open,
+                     struct damage_rect *rects, int max_rects)
+{
+    int count = 0;
+
+    if (max_rects <= 0 || !tile || y0 >= height)
+        return 0;
+
+    uint16_t cell = tile;
+    while ((width + cell - 1) / cell > 64)
+        cell *= 2;
+    int cols = (width + cell - 1) / cell;
+    uint16_t bh = height - y0 < tile ? height - y0 : tile;
+    uint64_t mask = band_mask(cur, prev, width, y0, bh, cell, cols, rows);
+
+    for (int c = 0; c < cols; ) {
+        if (!(mask & (1ULL << c))) {
+            c++;
+            continue;
+        }
+
+        /* One run of dirty cells, bridging gaps cheaper than a window */
+        int first = c, last = c;
+        while (++c < cols) {
+            if (mask & (1ULL << c)) {
+                last = c;
+                continue;
+            }
+            int g = c;
+            while (g < cols && !(mask & (1ULL << g)))
+                g++;
+            if (g == cols || (uint32_t)(g - c) * cell * bh >= window_cost)
+                break;
+            c = g - 1;
+        }
+
+        uint16_t x0 = (uint16_t)(first * cell);
+        uint16_t x1 = (uint16_t)((last + 1) * cell);
+        if (x1 > width)
+            x1 = width;
+        struct damage_rect r = { x0, y0, (uint16_t)(x1 - x0), bh };
+        rect_push(rects, &count, max_rects, &r);
+    }
+
+    /* Carry on with the open write where widening costs less than a window */
+    if (open && open->y + open->h == y0) {
+        for (int i = 0; i < count; i++) {
+            struct damage_rect *r = &rects[i];
+            if (r->x < open->x || r->x + r->w > open->x + open->w ||
+                (uint32_t)(open->w - r->w) * bh >= window_cost)
+                continue;
+            r->x = open->x;
+            r->w = open->w;
+            struct damage_rect t = rects[0];
+            rects[0] = *r;
+            *r = t;
+            break;
+        }
+    }
+    return count;
+}
+
+void damage_commit(uint16_t *prev, const uint16_t *cur, uint16_t width,
+                   const struct damage_rect *rects, int count)
+{
+    for (int i = 0; i < count; i++) {
+        const struct damage_rect *r = &rects[i];
+        for (uint16_t row = 0; row < r->h; row++) {
+            uint32_t off = (uint32_t)(r->y + row) * width + r->x;
+            memcpy(prev + off, cur + off, (size_t)r->w * sizeof(uint16_t));
+        }
+    }
+}
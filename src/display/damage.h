@@ -0,0 +1,74 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * damage.h — Frame-to-frame damage tracking for partial display updates
+ *
+ * Compares the freshly scaled RGB565 frame against the frame that was last
+ * pushed to the panel and reports the changed areas as a short list of
+ * rectangles.  Only those rectangles need a CASET/PASET/RAMWR window.
+ */
+
+#ifndef DAMAGE_H
+#define DAMAGE_H
+
+#include <stdint.h>
+
+/* Maximum number of rectangles reported per frame */
+#define DAMAGE_MAX_RECTS    16
+
+struct damage_rect {
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+};
+
+/*
+ * damage_diff() — Compare `cur` against `prev` (both `width * height`
+ *                 RGB565 pixels, tightly packed) and fill `rects` with the
+ *                 changed areas.
+ *
+ * Each run of consecutive changed rows becomes one rectangle spanning the
+ * union of their changed column ranges.  If more than `max_rects` runs are
+ * found, the excess is merged into the last rectangle.
+ *
+ * Returns the number of rectangles written (0 = frames are identical).
+ */
+int damage_diff(const uint16_t *cur, const uint16_t *prev,
+                uint16_t width, uint16_t height,
+                struct damage_rect *rects, int max_rects);
+
+/*
+ * damage_diff_band() — Tile-granular diff of one band of rows, for links
+ *                      where every window has a fixed cost on the bus and
+ *                      each band is sent as soon as it is ready.
+ *
+ * The band is rows `y0` .. `y0 + tile - 1` (clipped to `height`), cut into
+ * cells `tile` wide (doubled until at most 64 span the width); a cell is
+ * dirty if any of its pixels differ.  Only rows with `rows[y]` set are
+ * compared (NULL = all rows).  Runs of dirty cells become rectangles, and
+ * gaps are bridged whenever the clean pixels that adds number fewer than
+ * `window_cost` — the bus time of one extra window expressed in pixels.
+ * Excess rectangles beyond `max_rects` are merged into the last one.
+ *
+ * `open` (may be NULL) is the rectangle whose pixel write the panel could
+ * carry on with: the last one sent, ending at `y0`.  A rectangle within
+ * its columns is widened to them when that costs less than a window, and
+ * moved to the front, so the caller can continue the write instead of
+ * opening a new window.
+ *
+ * Returns the number of rectangles written (0 = band unchanged).
+ */
+int damage_diff_band(const uint16_t *cur, const uint16_t *prev,
+                     uint16_t width, uint16_t height, uint16_t y0,
+                     uint16_t tile, const uint8_t *rows, uint32_t window_cost,
+                     const struct damage_rect *open,
+                     struct damage_rect *rects, int max_rects);
+
+/*
+ * damage_commit() — Copy the `count` rectangles from `cur` into `prev`, so
+ *                   that `prev` again mirrors what the panel shows.
+ */
+void damage_commit(uint16_t *prev, const uint16_t *cur, uint16_t width,
+                   const struct damage_rect *rects, int count);
+
+#endif /* DAMAGE_H */
@@ -3,8 +3,14 @@
  * framebuffer.c — Mirror an existing Linux framebuffer to the ILI9481 TFT
  *
  * Opens /dev/fb0 (or whichever device is configured), mmaps it read-only,
- * and each frame converts pixels to 16-bit RGB565 + nearest-neighbor
- * scales to the TFT resolution before flushing to the display via GPIO.
+ * and each frame hashes the source rows; rows that changed are converted
+ * to 16-bit RGB565 and scaled (nearest-neighbor or box filter) to the TFT
+ * resolution.  The result is diffed against the frame last pushed to the
+ * panel and only the changed rectangles are flushed to the display via
+ * GPIO — an idle desktop costs one hash pass and no bus cycles at all.
+ *
+ * On multi-core Pis the scale/diff stage can run on its own thread so that
+ * frame N+1 is prepared while frame N is on the bus.
  *
  * RGB565 packing: bits [15:11]=R(5), [10:5]=G(6), [4:0]=B(5).
  * Sent over the 8-bit bus as two bus cycles per pixel (high byte first).
@@ -12,6 +18,8 @@
  * No kernel modules are loaded — works with the stock vc4drmfb framebuffer.
  */
 
+#define _GNU_SOURCE     /* pthread_setaffinity_np, CPU_SET */
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -20,14 +28,23 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdatomic.h>
 #include <sys/mman.h>
 #include <sys/ioctl.h>
 #include <linux/fb.h>
 
 #include "framebuffer.h"
 #include "ili9481.h"
+#include "damage.h"
+#include "convert.h"
+#include "scaler.h"
+#include "rowhash.h"
 #include "../bus/gpio_mmio.h"
 #include "../core/logging.h"
+#include "../core/pacer.h"
 
 /* ------------------------------------------------------------------ */
 /* Internal state                                                     */
@@ -52,8 +69,32 @@ struct fb_provider {
     uint32_t    blue_offset;
     uint32_t    blue_length;
 
+    /* 8:8:8 channel layout for the SIMD path (valid if fast32 is set) */
+    struct convert_layout layout;
+    int         fast32;
+
+    /* Source row/column index maps (+ box filter taps) for scaling */
+    struct scaler scaler;
+    struct scaler_format format;
+
+    /* Source change detection: only rows that changed are re-scaled */
+    struct rowhash rowhash;
+    uint8_t    *dirty_rows;     /* tft_height entries                */
+
     /* Pre-allocated scale buffer (TFT-sized, RGB565 in uint16_t) */
     uint16_t   *scale_buf;
+
+    /* Copy of what the panel currently shows, for damage tracking */
+    uint16_t   *shadow_buf;
+    int         shadow_valid;   /* 0 until the first full flush      */
+
+    /* Frame pacing: drops to idle_fps when nothing changes */
+    struct pacer pacer;
+    int         idle_fps;
+    uint32_t    idle_after;     /* undamaged frames before backing off */
+
+    int         stream;         /* pre-expand pixels into bus words  */
+    int         pipeline;       /* scale on a second thread          */
     uint32_t    tft_width;
     uint32_t    tft_height;
 };
@@ -92,28 +133,13 @@ static inline uint16_t pixel32_to_rgb565(uint32_t px,
 
 static void scale_frame(struct fb_provider *fb)
 {
+    struct scaler *sc = &fb->scaler;
     const uint32_t tw = fb->tft_width;
     const uint32_t th = fb->tft_height;
-    const uint32_t sw = fb->src_width;
-    const uint32_t sh = fb->src_height;
     const uint32_t stride = fb->src_stride;
+    const uint32_t *xmap = sc->xmap;
     const uint8_t *src = fb->map;
 
-    if (fb->src_bpp == 16) {
-        /* 16bpp source is already RGB565 — just scale (no conversion) */
-        for (uint32_t dy = 0; dy < th; dy++) {
-            uint32_t sy = dy * sh / th;
-            const uint16_t *srow = (const uint16_t *)(src + sy * stride);
-            uint16_t *drow = &fb->scale_buf[dy * tw];
-            for (uint32_t dx = 0; dx < tw; dx++) {
-                uint32_t sx = dx * sw / tw;
-                drow[dx] = srow[sx];
-            }
-        }
-        return;
-    }
-
-    /* 32bpp source: convert to RGB565 + scale in one pass */
     const uint32_t r_off = fb->red_offset;
     const uint32_t r_len = fb->red_length;
     const uint32_t g_off = fb->green_offset;
@@ -122,19 +148,398 @@ static void scale_frame(struct fb_provider *fb)
     const uint32_t b_len = fb->blue_length;
 
     for (uint32_t dy = 0; dy < th; dy++) {
-        uint32_t sy = dy * sh / th;
-        const uint32_t *srow = (const uint32_t *)(src + sy * stride);
         uint16_t *drow = &fb->scale_buf[dy * tw];
-        for (uint32_t dx = 0; dx < tw; dx++) {
-            uint32_t sx = dx * sw / tw;
-            drow[dx] = pixel32_to_rgb565(srow[sx],
-                                          r_off, r_len,
-                                          g_off, g_len,
-                                          b_off, b_len);
+        const uint8_t *srow = src + sc->ymap[dy] * stride;
+
+        /* Source rows behind this one are unchanged: keep last frame's row */
+        if (!fb->dirty_rows[dy])
+            continue;
+
+        /* Upscaled rows that sample the same source row are plain copies */
+        if (sc->row_dup[dy]) {
+            memcpy(drow, drow - tw, tw * sizeof(uint16_t));
+            continue;
+        }
+
+        if (sc->filter == SCALE_FILTER_BOX) {
+            /* Area average of every covered source pixel */
+            scaler_box_row(sc, dy, src, stride, &fb->format, drow);
+        } else if (fb->src_bpp == 16) {
+            /* 16bpp source is already RGB565 — just scale (no conversion) */
+            convert_row_16(drow, (const uint16_t *)srow, xmap, tw);
+        } else if (fb->fast32) {
+            /* 32bpp with 8-bit channels: SIMD convert + scale in one pass */
+            convert_row_32(drow, (const uint32_t *)srow, xmap, tw, &fb->layout);
+        } else {
+            /* Any other 32bpp layout: generic per-pixel conversion */
+            const uint32_t *s32 = (const uint32_t *)srow;
+            for (uint32_t dx = 0; dx < tw; dx++) {
+                drow[dx] = pixel32_to_rgb565(s32[xmap[dx]],
+                                              r_off, r_len,
+                                              g_off, g_len,
+                                              b_off, b_len);
+            }
         }
     }
 }
 
+/* ------------------------------------------------------------------ */
+/* Frame preparation: scale, diff, (optionally) expand                */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Hash the source rows, scale the rows that changed into fb->scale_buf
+ * and diff the result against the shadow.  An unchanged source returns
+ * straight after hashing.  The first frame is always reported as one
+ * full-screen rect.  The shadow is NOT updated — call commit_frame() once
+ * the rectangles have been handed to the bus.
+ *
+ * Returns the number of damaged rectangles in `rects`.
+ */
+static int prepare_frame(struct fb_provider *fb, struct damage_rect *rects)
+{
+    uint32_t changed = rowhash_scan(&fb->rowhash, fb->map, fb->src_stride,
+                                    fb->src_width * (fb->src_bpp / 8));
+    if (changed == 0 && fb->shadow_valid)
+        return 0;
+
+    scaler_dirty_rows(&fb->scaler, fb->rowhash.changed, fb->dirty_rows);
+    scale_frame(fb);
+
+    if (!fb->shadow_valid) {
+        rects[0] = (struct damage_rect){ 0, 0, fb->tft_width, fb->tft_height };
+        return 1;
+    }
+
+    return damage_diff(fb->scale_buf, fb->shadow_buf,
+                       fb->tft_width, fb->tft_height,
+                       rects, DAMAGE_MAX_RECTS);
+}
+
+static void commit_frame(struct fb_provider *fb,
+                         const struct damage_rect *rects, int count)
+{
+    damage_commit(fb->shadow_buf, fb->scale_buf, fb->tft_width, rects, count);
+    fb->shadow_valid = 1;
+}
+
+/*
+ * Stream mode: expand each rectangle's pixels into `words`, back to back,
+ * in the layout expected by ili9481_flush_rects_words().
+ */
+static void expand_rects(const struct fb_provider *fb, const struct gpio_bus *bus,
+                         const struct damage_rect *rects, int count,
+                         struct gpio_word *words)
+{
+    for (int i = 0; i < count; i++) {
+        const struct damage_rect *r = &rects[i];
+        const uint16_t *row = fb->scale_buf + (uint32_t)r->y * fb->tft_width + r->x;
+        for (uint16_t y = 0; y < r->h; y++, row += fb->tft_width) {
+            gpio_expand_pixels(bus, row, r->w, words);
+            words += (uint32_t)r->w * 2;
+        }
+    }
+}
+
+static struct gpio_word *alloc_words(const struct fb_provider *fb)
+{
+    return calloc((size_t)fb->tft_width * fb->tft_height * 2,
+                  sizeof(struct gpio_word));
+}
+
+/* ------------------------------------------------------------------ */
+/* Frame timing                                                       */
+/* ------------------------------------------------------------------ */
+
+/* Seconds between "Actual FPS" reports */
+#define FPS_LOG_INTERVAL    10.0
+
+/*
+ * Log once *next_log seconds have passed since start, then move it on by
+ * FPS_LOG_INTERVAL.  Timed on the clock rather than counted in ticks, so
+ * the period holds while the pacer runs at idle_fps.  The rate is frames
+ * actually pushed to the panel; idle ticks (nothing changed) and busy
+ * ticks (bus still full) are reported separately.
+ */
+static void log_fps(const struct timespec *start, double *next_log,
+                    unsigned int ticks, unsigned int pushed,
+                    unsigned int idle, unsigned int busy)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double elapsed = (now.tv_sec - start->tv_sec)
+                   + (now.tv_nsec - start->tv_nsec) / 1e9;
+    if (elapsed < *next_log)
+        return;
+
+    *next_log = elapsed + FPS_LOG_INTERVAL;
+    log_info("Actual FPS: %.1f (frames=%u, ticks=%u, idle=%u, busy=%u, elapsed=%.1fs)",
+             pushed / elapsed, pushed, ticks, idle, busy, elapsed);
+}
+
+/* ------------------------------------------------------------------ */
+/* Serial loop: scale → diff → push on the calling thread             */
+/* ------------------------------------------------------------------ */
+
+static void flush_loop_serial(struct fb_provider *fb, struct gpio_bus *bus,
+                              int fps, volatile int *running)
+{
+    struct timespec fps_start;
+    double next_log = FPS_LOG_INTERVAL;
+    unsigned int frame_count = 0;
+    unsigned int idle_count = 0;
+    struct damage_rect rects[DAMAGE_MAX_RECTS];
+    struct gpio_word *words = NULL;
+
+    if (fb->stream) {
+        words = alloc_words(fb);
+        if (!words)
+            log_warn("Cannot allocate stream buffer — using per-byte lookups");
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fps_start);
+    pacer_start(&fb->pacer, fps, fb->idle_fps, fb->idle_after);
+
+    while (*running) {
+        /* Wait until the next frame time (or a touch kick) */
+        pacer_wait(&fb->pacer);
+
+        /* Convert, scale and work out which parts of the panel are stale */
+        int nrects = prepare_frame(fb, rects);
+
+        /* Flush only the changed rectangles to the display */
+        if (words) {
+            expand_rects(fb, bus, rects, nrects, words);
+            ili9481_flush_rects_words(bus, rects, nrects, words);
+        } else {
+            ili9481_flush_rects(bus, rects, nrects, fb->scale_buf, fb->tft_width);
+        }
+        commit_frame(fb, rects, nrects);
+
+        if (nrects == 0)
+            idle_count++;
+        frame_count++;
+        log_fps(&fps_start, &next_log, frame_count, frame_count - idle_count,
+                idle_count, 0);
+
+        /* Schedule the next tick: target rate, or idle rate if quiet */
+        pacer_frame(&fb->pacer, nrects > 0);
+    }
+
+    free(words);
+    log_info("Flush loop stopped after %u frames", frame_count);
+}
+
+/* ------------------------------------------------------------------ */
+/* Pipelined loop: scaler thread → SPSC slot ring → bus thread        */
+/* ------------------------------------------------------------------ */
+
+/*
+ * The scaler thread owns scale_buf/shadow_buf and produces frame N+1 while
+ * the bus thread pushes frame N.  Each slot carries one frame's damage
+ * list plus its pixels (a full-size frame in which only the rects are
+ * valid) or, in stream mode, its pre-expanded bus words.
+ *
+ * `head` is only written by the scaler and `tail` only by the bus thread;
+ * release/acquire on those two counters is the sole synchronisation for
+ * slot contents.  The semaphore is just a wake-up for the bus thread.
+ */
+#define FB_PIPELINE_SLOTS   2
+
+struct fb_slot {
+    struct damage_rect  rects[DAMAGE_MAX_RECTS];
+    int                 nrects;
+    uint16_t           *frame;      /* non-stream mode                  */
+    struct gpio_word   *words;      /* stream mode                      */
+};
+
+struct fb_pipeline {
+    struct fb_provider     *fb;
+    const struct gpio_bus  *bus;
+    int                     fps;
+    int                     scaler_cpu;
+    volatile int           *running;
+
+    struct fb_slot          slots[FB_PIPELINE_SLOTS];
+    atomic_uint             head;   /* next slot to fill  (scaler)      */
+    atomic_uint             tail;   /* next slot to drain (bus thread)  */
+    sem_t                   ready;  /* posted once per published slot   */
+};
+
+static void pin_to_cpu(pthread_t thread, int cpu, const char *what)
+{
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(thread, sizeof(set), &set) != 0)
+        log_warn("Cannot pin %s thread to CPU %d", what, cpu);
+    else
+        log_info("%s thread pinned to CPU %d", what, cpu);
+}
+
+static void *scaler_thread_fn(void *arg)
+{
+    struct fb_pipeline *p = arg;
+    struct fb_provider *fb = p->fb;
+    struct timespec fps_start;
+    double next_log = FPS_LOG_INTERVAL;
+    unsigned int tick_count = 0;
+    unsigned int published = 0;
+    unsigned int idle_count = 0;
+    unsigned int busy_count = 0;
+
+    pin_to_cpu(pthread_self(), p->scaler_cpu, "Scaler");
+
+    clock_gettime(CLOCK_MONOTONIC, &fps_start);
+    pacer_start(&fb->pacer, p->fps, fb->idle_fps, fb->idle_after);
+
+    while (*p->running) {
+        pacer_wait(&fb->pacer);
+        tick_count++;
+        log_fps(&fps_start, &next_log, tick_count, published, idle_count,
+                busy_count);
+
+        unsigned int head = atomic_load_explicit(&p->head, memory_order_relaxed);
+        unsigned int tail = atomic_load_explicit(&p->tail, memory_order_acquire);
+
+        /*
+         * Both slots in flight: the bus is the bottleneck.  Skip this tick
+         * without touching the shadow, so the damage is picked up (and
+         * merged with newer changes) on the next one.
+         */
+        if (head - tail >= FB_PIPELINE_SLOTS) {
+            busy_count++;
+            pacer_frame(&fb->pacer, 1);
+            continue;
+        }
+
+        struct fb_slot *slot = &p->slots[head % FB_PIPELINE_SLOTS];
+        int nrects = prepare_frame(fb, slot->rects);
+        pacer_frame(&fb->pacer, nrects > 0);
+        if (nrects == 0) {
+            idle_count++;
+            continue;
+        }
+
+        if (slot->words)
+            expand_rects(fb, p->bus, slot->rects, nrects, slot->words);
+        else
+            damage_commit(slot->frame, fb->scale_buf, fb->tft_width,
+                          slot->rects, nrects);
+        slot->nrects = nrects;
+        commit_frame(fb, slot->rects, nrects);
+
+        atomic_store_explicit(&p->head, head + 1, memory_order_release);
+        sem_post(&p->ready);
+        published++;
+    }
+
+    log_info("Scaler thread stopped after %u ticks: %u frames published, "
+             "%u idle, bus busy on %u", tick_count, published, idle_count,
+             busy_count);
+
+    /* Extra post with no slot behind it tells the bus thread to exit */
+    sem_post(&p->ready);
+    return NULL;
+}
+
+static void pipeline_free_slots(struct fb_pipeline *p)
+{
+    for (int i = 0; i < FB_PIPELINE_SLOTS; i++) {
+        free(p->slots[i].frame);
+        free(p->slots[i].words);
+    }
+}
+
+static int pipeline_alloc_slots(struct fb_pipeline *p)
+{
+    struct fb_provider *fb = p->fb;
+
+    for (int i = 0; i < FB_PIPELINE_SLOTS; i++) {
+        if (fb->stream)
+            p->slots[i].words = alloc_words(fb);
+        else
+            p->slots[i].frame = calloc((size_t)fb->tft_width * fb->tft_height,
+                                       sizeof(uint16_t));
+        if (!p->slots[i].words && !p->slots[i].frame) {
+            pipeline_free_slots(p);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Run the pipelined loop.  Returns -1 without having flushed anything if
+ * the pipeline cannot be set up, so the caller can fall back to serial.
+ */
+static int flush_loop_pipelined(struct fb_provider *fb, struct gpio_bus *bus,
+                                int fps, volatile int *running)
+{
+    struct fb_pipeline p;
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int pushed = 0;
+    pthread_t tid;
+
+    if (ncpu < 2) {
+        log_warn("Pipeline needs at least 2 CPU cores (found %ld)", ncpu);
+        return -1;
+    }
+
+    memset(&p, 0, sizeof(p));
+    p.fb         = fb;
+    p.bus        = bus;
+    p.fps        = fps;
+    p.running    = running;
+    p.scaler_cpu = (int)ncpu - 2;
+    atomic_init(&p.head, 0);
+    atomic_init(&p.tail, 0);
+
+    if (pipeline_alloc_slots(&p) < 0) {
+        log_warn("Cannot allocate pipeline slots");
+        return -1;
+    }
+    sem_init(&p.ready, 0, 0);
+
+    if (pthread_create(&tid, NULL, scaler_thread_fn, &p) != 0) {
+        log_warn("Cannot create scaler thread");
+        sem_destroy(&p.ready);
+        pipeline_free_slots(&p);
+        return -1;
+    }
+
+    /* The bus thread (this one) gets the last core, away from IRQ-heavy CPU 0 */
+    pin_to_cpu(pthread_self(), (int)ncpu - 1, "Bus");
+
+    for (;;) {
+        if (sem_wait(&p.ready) < 0)
+            continue;   /* EINTR (signal) — the scaler will post on exit */
+
+        unsigned int tail = atomic_load_explicit(&p.tail, memory_order_relaxed);
+        unsigned int head = atomic_load_explicit(&p.head, memory_order_acquire);
+        if (tail == head)
+            break;      /* scaler has exited and everything is drained */
+
+        const struct fb_slot *slot = &p.slots[tail % FB_PIPELINE_SLOTS];
+        if (slot->words)
+            ili9481_flush_rects_words(bus, slot->rects, slot->nrects, slot->words);
+        else
+            ili9481_flush_rects(bus, slot->rects, slot->nrects,
+                                slot->frame, fb->tft_width);
+        pushed++;
+
+        atomic_store_explicit(&p.tail, tail + 1, memory_order_release);
+    }
+
+    pthread_join(tid, NULL);
+    sem_destroy(&p.ready);
+    pipeline_free_slots(&p);
+
+    log_info("Flush loop stopped after %u pushed frames", pushed);
+    return 0;
+}
+
 /* ------------------------------------------------------------------ */
 /* Public API                                                         */
 /* ------------------------------------------------------------------ */
@@ -195,8 +600,18 @@ struct fb_provider *fb_provider_init(const char *fb_device,
         return NULL;
     }
 
+    uint16_t *shadow_buf = calloc((uint32_t)tft_width * tft_height, sizeof(uint16_t));
+    if (!shadow_buf) {
+        log_error("Cannot allocate shadow buffer (%ux%u)", tft_width, tft_height);
+        free(scale_buf);
+        munmap(map, mmap_size);
+        close(fd);
+        return NULL;
+    }
+
     struct fb_provider *fb = calloc(1, sizeof(*fb));
     if (!fb) {
+        free(shadow_buf);
         free(scale_buf);
         munmap(map, mmap_size);
         close(fd);
@@ -217,67 +632,116 @@ struct fb_provider *fb_provider_init(const char *fb_device,
     fb->blue_offset  = vinfo.blue.offset;
     fb->blue_length  = vinfo.blue.length;
     fb->scale_buf   = scale_buf;
+    fb->shadow_buf  = shadow_buf;
+    fb->fast32      = vinfo.bits_per_pixel == 32 &&
+                      convert_layout_init(&fb->layout,
+                                          fb->red_offset, fb->red_length,
+                                          fb->green_offset, fb->green_length,
+                                          fb->blue_offset, fb->blue_length) == 0;
+    fb->format      = (struct scaler_format){
+        .bpp   = fb->src_bpp,
+        .r_off = fb->red_offset,   .r_len = fb->red_length,
+        .g_off = fb->green_offset, .g_len = fb->green_length,
+        .b_off = fb->blue_offset,  .b_len = fb->blue_length,
+    };
     fb->tft_width   = tft_width;
     fb->tft_height  = tft_height;
 
+    if (pacer_init(&fb->pacer) < 0) {
+        log_error("Cannot initialise frame pacer");
+        free(shadow_buf);
+        free(scale_buf);
+        free(fb);
+        munmap(map, mmap_size);
+        close(fd);
+        return NULL;
+    }
+
+    if (scaler_init(&fb->scaler, fb->src_width, fb->src_height,
+                    tft_width, tft_height, SCALE_FILTER_NEAREST) < 0) {
+        log_error("Cannot allocate scaler maps (%ux%u)", tft_width, tft_height);
+        fb_provider_destroy(fb);
+        return NULL;
+    }
+
+    fb->dirty_rows = calloc(tft_height, 1);
+    if (!fb->dirty_rows || rowhash_init(&fb->rowhash, fb->src_height) < 0) {
+        log_error("Cannot allocate row hashes (%u rows)", fb->src_height);
+        fb_provider_destroy(fb);
+        return NULL;
+    }
+
     log_info("Source framebuffer %s: %ux%u %ubpp (stride=%u)",
              fb_device, fb->src_width, fb->src_height,
              fb->src_bpp, fb->src_stride);
-    log_info("TFT target: %ux%u RGB565 — scale+convert",
-             tft_width, tft_height);
+    log_info("TFT target: %ux%u RGB565 — scale+convert (%s)",
+             tft_width, tft_height,
+             fb->src_bpp == 16 ? "copy" : fb->fast32 ? "SIMD" : "generic");
 
     return fb;
 }
 
-void fb_flush_loop(struct fb_provider *fb, struct gpio_bus *bus,
-                   uint16_t tft_width, uint16_t tft_height,
-                   int fps, volatile int *running)
+void fb_provider_set_stream(struct fb_provider *fb, int enable)
 {
-    struct timespec next_tick;
-    long frame_ns = 1000000000L / fps;
-    unsigned int frame_count = 0;
-    struct timespec fps_start;
+    fb->stream = enable ? 1 : 0;
+}
 
-    clock_gettime(CLOCK_MONOTONIC, &next_tick);
-    fps_start = next_tick;
+void fb_provider_set_pipeline(struct fb_provider *fb, int enable)
+{
+    fb->pipeline = enable ? 1 : 0;
+}
 
-    log_info("Flush loop starting: mirror %ux%u %ubpp → %ux%u RGB565 @ %d FPS",
-             fb->src_width, fb->src_height, fb->src_bpp,
-             tft_width, tft_height, fps);
+void fb_provider_set_idle(struct fb_provider *fb, int idle_fps,
+                          uint32_t idle_after)
+{
+    fb->idle_fps   = idle_fps;
+    fb->idle_after = idle_after;
+}
 
-    while (*running) {
-        /* Wait until the next frame time */
-        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_tick, NULL);
+void fb_provider_kick(struct fb_provider *fb)
+{
+    pacer_kick(&fb->pacer);
+}
 
-        /* Convert and scale the source framebuffer into the TFT buffer */
-        scale_frame(fb);
+void fb_provider_set_filter(struct fb_provider *fb, enum scale_filter filter)
+{
+    struct scaler next = { 0 };
 
-        /* Flush the scaled RGB565 buffer to the display */
-        ili9481_flush_full(bus, tft_width, tft_height, fb->scale_buf);
+    if (fb->scaler.filter == filter)
+        return;
 
-        frame_count++;
+    /* Build the new tables first so a failed allocation keeps the old ones */
+    if (scaler_init(&next, fb->src_width, fb->src_height,
+                    fb->tft_width, fb->tft_height, filter) < 0) {
+        log_warn("Cannot allocate scaler filter tables, keeping nearest-neighbour");
+        return;
+    }
+    scaler_free(&fb->scaler);
+    fb->scaler = next;
 
-        /* Log actual FPS every 10 seconds */
-        if (frame_count % (unsigned int)(fps * 10) == 0) {
-            struct timespec now;
-            clock_gettime(CLOCK_MONOTONIC, &now);
-            double elapsed = (now.tv_sec - fps_start.tv_sec)
-                           + (now.tv_nsec - fps_start.tv_nsec) / 1e9;
-            if (elapsed > 0.0) {
-                log_info("Actual FPS: %.1f (frames=%u, elapsed=%.1fs)",
-                         frame_count / elapsed, frame_count, elapsed);
-            }
-        }
+    /* Every row must be re-scaled with the new filter */
+    fb->rowhash.valid = 0;
+}
 
-        /* Advance to the next tick (absolute time) */
-        next_tick.tv_nsec += frame_ns;
-        while (next_tick.tv_nsec >= 1000000000L) {
-            next_tick.tv_nsec -= 1000000000L;
-            next_tick.tv_sec++;
-        }
+void fb_flush_loop(struct fb_provider *fb, struct gpio_bus *bus,
+                   uint16_t tft_width, uint16_t tft_height,
+                   int fps, volatile int *running)
+{
+    log_info("Flush loop starting: mirror %ux%u %ubpp → %ux%u RGB565 @ %d FPS "
+             "(%s, %s, %s)",
+             fb->src_width, fb->src_height, fb->src_bpp,
+             tft_width, tft_height, fps,
+             fb->scaler.filter == SCALE_FILTER_BOX ? "box" : "nearest",
+             fb->pipeline ? "pipelined" : "serial",
+             fb->stream ? "stream" : "lookup");
+
+    if (fb->pipeline) {
+        if (flush_loop_pipelined(fb, bus, fps, running) == 0)
+            return;
+        log_warn("Falling back to the serial flush loop");
     }
 
-    log_info("Flush loop stopped after %u frames", frame_count);
+    flush_loop_serial(fb, bus, fps, running);
 }
 
 void fb_provider_destroy(struct fb_provider *fb)
@@ -288,6 +752,14 @@ void fb_provider_destroy(struct fb_provider *fb)
     if (fb->scale_buf)
         free(fb->scale_buf);
 
+    if (fb->shadow_buf)
+        free(fb->shadow_buf);
+
+    scaler_free(&fb->scaler);
+    rowhash_free(&fb->rowhash);
+    free(fb->dirty_rows);
+    pacer_destroy(&fb->pacer);
+
     if (fb->map && fb->map != MAP_FAILED)
         munmap(fb->map, fb->map_size);
 
@@ -15,6 +15,8 @@
 
 #include <stdint.h>
 
+#include "scaler.h"
+
 struct gpio_bus;
 
 /* Opaque framebuffer provider handle */
@@ -29,22 +31,81 @@ struct fb_provider;
  * `tft_width` and `tft_height` are the target TFT panel dimensions.
  *
  * The source framebuffer may be any resolution and 16 or 32 bpp;
- * the flush loop handles format conversion and nearest-neighbor scaling.
+ * the flush loop handles format conversion and scaling (nearest-neighbor
+ * unless fb_provider_set_filter() selects the box filter).
  *
  * Returns a provider handle on success, NULL on failure.
  */
 struct fb_provider *fb_provider_init(const char *fb_device,
                                      uint16_t tft_width, uint16_t tft_height);
 
+/*
+ * fb_provider_set_stream() — Enable or disable stream mode.
+ *
+ * In stream mode each damaged rectangle is first expanded into
+ * ready-to-store GPIO register words (gpio_expand_pixels()), and the bus
+ * loop then only performs sequential stores (gpio_write_words()) with no
+ * per-byte table lookups.  Costs 16 bytes of memory per panel pixel (per
+ * pipeline slot).  Falls back to per-byte lookups if allocation fails.
+ */
+void fb_provider_set_stream(struct fb_provider *fb, int enable);
+
+/*
+ * fb_provider_set_pipeline() — Enable or disable the two-stage pipeline.
+ *
+ * When enabled, fb_flush_loop() runs scale + diff (+ stream expansion) on
+ * a second thread pinned to its own core, handing finished frames to the
+ * bus thread through a lock-free two-slot ring.  If the bus falls behind,
+ * ticks are skipped and their damage is folded into the next frame.
+ * Ignored (serial loop) on single-core Pis.
+ */
+void fb_provider_set_pipeline(struct fb_provider *fb, int enable);
+
+/*
+ * fb_provider_set_idle() — Configure adaptive frame pacing.
+ *
+ * After `idle_after` consecutive frames without damage the flush loop
+ * polls the source at only `idle_fps`; the first damaged frame, or a
+ * call to fb_provider_kick(), returns it to the full rate.
+ * `idle_after` = 0 (the default) keeps the full rate at all times.
+ * Must be called before fb_flush_loop().
+ */
+void fb_provider_set_idle(struct fb_provider *fb, int idle_fps,
+                          uint32_t idle_after);
+
+/*
+ * fb_provider_kick() — Signal user activity (e.g. a touch event).
+ *
+ * If the flush loop is idling it wakes at once and returns to the full
+ * frame rate.  Safe to call from any thread.
+ */
+void fb_provider_kick(struct fb_provider *fb);
+
+/*
+ * fb_provider_set_filter() — Select the downscaling filter.
+ *
+ * SCALE_FILTER_NEAREST (default) samples one source pixel per panel
+ * pixel.  SCALE_FILTER_BOX averages every source pixel a panel pixel
+ * covers, which keeps thin text readable at 720p and above but reads the
+ * whole source frame each tick.  Keeps the current filter if the tables
+ * cannot be allocated.  Must be called before fb_flush_loop().
+ */
+void fb_provider_set_filter(struct fb_provider *fb, enum scale_filter filter);
+
 /*
  * fb_flush_loop() — Run the mirror-to-display loop.
  *
  * Each frame: reads from the mmap'd source fb, converts pixel format
  * (32bpp XRGB8888 → RGB565 if needed), scales to tft_width × tft_height
- * via nearest-neighbor, and calls ili9481_flush_full().
+ * with the selected filter, diffs the result against the previously flushed
+ * frame, and passes the changed rectangles to ili9481_flush_rects().
+ * The first frame is always flushed in full; unchanged frames cost no
+ * bus cycles.
  *
- * Uses clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME) for timing.
+ * Ticks on absolute CLOCK_MONOTONIC deadlines (see fb_provider_set_idle()
+ * for the idle back-off).
  * Runs until `*running` becomes 0.  Logs actual FPS every 10 seconds.
+ * See fb_provider_set_pipeline() for the threaded variant.
  */
 void fb_flush_loop(struct fb_provider *fb, struct gpio_bus *bus,
                    uint16_t tft_width, uint16_t tft_height,
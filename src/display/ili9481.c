@@ -10,6 +10,7 @@
 #include <unistd.h>
 
 #include "ili9481.h"
+#include "damage.h"
 #include "../bus/gpio_mmio.h"
 #include "../core/logging.h"
 #include "ili9481_hw.h"
@@ -76,6 +77,74 @@ static uint8_t ili9481_madctl_for_rotate(uint32_t rotate)
     }
 }
 
+/* ------------------------------------------------------------------ */
+/* Address window                                                     */
+/* ------------------------------------------------------------------ */
+
+/* Program CASET or PASET (`cmd`) with the inclusive range [a0..a1]. */
+static void ili9481_set_range(struct gpio_bus *bus, uint8_t cmd,
+                              uint16_t a0, uint16_t a1)
+{
+    gpio_write_cmd(bus, cmd);
+    gpio_write_data(bus, a0 >> 8);
+    gpio_write_data(bus, a0 & 0xFF);
+    gpio_write_data(bus, a1 >> 8);
+    gpio_write_data(bus, a1 & 0xFF);
+}
+
+/*
+ * Last programmed CASET/PASET ranges.  RAMWR always restarts at the window
+ * origin, so a register only has to be rewritten when its range actually
+ * changes: a rectangle in the same columns as the previous one skips
+ * CASET, one in the same rows skips PASET — one command and four data
+ * cycles each.  0xFFFF never matches a valid coordinate.
+ */
+struct window_cache {
+    uint16_t cx0, cx1;
+    uint16_t py0, py1;
+};
+
+#define WINDOW_CACHE_INIT   { 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF }
+
+/* Program the window of `r`, skipping ranges the panel already holds. */
+static void ili9481_window_for(struct gpio_bus *bus, struct window_cache *wc,
+                               const struct damage_rect *r)
+{
+    uint16_t x1 = r->x + r->w - 1;
+    uint16_t y1 = r->y + r->h - 1;
+
+    if (r->x != wc->cx0 || x1 != wc->cx1) {
+        ili9481_set_range(bus, ILI9481_CASET, r->x, x1);
+        wc->cx0 = r->x;
+        wc->cx1 = x1;
+    }
+    if (r->y != wc->py0 || y1 != wc->py1) {
+        ili9481_set_range(bus, ILI9481_PASET, r->y, y1);
+        wc->py0 = r->y;
+        wc->py1 = y1;
+    }
+}
+
+/*
+ * Stream one rectangle after its window has been programmed.  Rectangles
+ * spanning the full source pitch are contiguous and go out in one call.
+ */
+static void ili9481_stream_rect(struct gpio_bus *bus,
+                                uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                                const uint16_t *pixels, uint32_t stride)
+{
+    /* Begin memory write and stream the rectangle row by row */
+    gpio_write_cmd(bus, ILI9481_RAMWR);
+
+    const uint16_t *row = pixels + (uint32_t)y * stride + x;
+    if (stride == w) {
+        gpio_write_pixels(bus, row, (uint32_t)w * h);
+        return;
+    }
+    for (uint16_t r = 0; r < h; r++, row += stride)
+        gpio_write_pixels(bus, row, w);
+}
+
 /* ------------------------------------------------------------------ */
 /* Public API                                                         */
 /* ------------------------------------------------------------------ */
@@ -110,23 +179,52 @@ void ili9481_flush_full(struct gpio_bus *bus,
                         uint16_t width, uint16_t height,
                         const uint16_t *pixels)
 {
-    /* Column address range — full width */
-    gpio_write_cmd(bus, ILI9481_CASET);
-    gpio_write_data(bus, 0x00);
-    gpio_write_data(bus, 0x00);
-    gpio_write_data(bus, (width - 1) >> 8);
-    gpio_write_data(bus, (width - 1) & 0xFF);
-
-    /* Page (row) address range — full height */
-    gpio_write_cmd(bus, ILI9481_PASET);
-    gpio_write_data(bus, 0x00);
-    gpio_write_data(bus, 0x00);
-    gpio_write_data(bus, (height - 1) >> 8);
-    gpio_write_data(bus, (height - 1) & 0xFF);
-
-    /* Begin memory write and stream all pixels */
-    gpio_write_cmd(bus, ILI9481_RAMWR);
-    gpio_write_pixels(bus, pixels, (uint32_t)width * height);
+    ili9481_flush_rect(bus, 0, 0, width, height, pixels, width);
+}
+
+void ili9481_flush_rect(struct gpio_bus *bus,
+                        uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                        const uint16_t *pixels, uint32_t stride)
+{
+    struct damage_rect r = { x, y, w, h };
+
+    ili9481_flush_rects(bus, &r, 1, pixels, stride);
+}
+
+void ili9481_flush_rects(struct gpio_bus *bus,
+                         const struct damage_rect *rects, int count,
+                         const uint16_t *pixels, uint32_t stride)
+{
+    struct window_cache wc = WINDOW_CACHE_INIT;
+
+    for (int i = 0; i < count; i++) {
+        const struct damage_rect *r = &rects[i];
+        if (r->w == 0 || r->h == 0)
+            continue;
+
+        ili9481_window_for(bus, &wc, r);
+        ili9481_stream_rect(bus, r->x, r->y, r->w, r->h, pixels, stride);
+    }
+}
+
+void ili9481_flush_rects_words(struct gpio_bus *bus,
+                               const struct damage_rect *rects, int count,
+                               const struct gpio_word *words)
+{
+    struct window_cache wc = WINDOW_CACHE_INIT;
+
+    for (int i = 0; i < count; i++) {
+        const struct damage_rect *r = &rects[i];
+        if (r->w == 0 || r->h == 0)
+            continue;
+
+        uint32_t nwords = (uint32_t)r->w * r->h * 2;
+
+        ili9481_window_for(bus, &wc, r);
+        gpio_write_cmd(bus, ILI9481_RAMWR);
+        gpio_write_words(bus, words, nwords);
+        words += nwords;
+    }
 }
 
 void ili9481_power_off(struct gpio_bus *bus)
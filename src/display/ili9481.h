@@ -9,6 +9,8 @@
 #include <stdint.h>
 
 struct gpio_bus;
+struct damage_rect;
+struct gpio_word;
 
 /*
  * ili9481_init() — Hardware reset + send full init command sequence + apply
@@ -29,6 +31,40 @@ void ili9481_flush_full(struct gpio_bus *bus,
                         uint16_t width, uint16_t height,
                         const uint16_t *pixels);
 
+/*
+ * ili9481_flush_rect() — Write the `w × h` rectangle at (`x`, `y`) to the
+ *                        display, setting a CASET/PASET window around it.
+ *
+ * `pixels` points to the top-left of the full source frame (RGB565) and
+ * `stride` is its row pitch in pixels; only the rectangle is streamed.
+ */
+void ili9481_flush_rect(struct gpio_bus *bus,
+                        uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                        const uint16_t *pixels, uint32_t stride);
+
+/*
+ * ili9481_flush_rects() — Flush `count` rectangles from the same source
+ *                         frame in one batch.
+ *
+ * Equivalent to calling ili9481_flush_rect() for each entry, but CASET or
+ * PASET is only re-sent when its range differs from the previous rectangle.
+ * Empty rectangles are skipped.
+ */
+void ili9481_flush_rects(struct gpio_bus *bus,
+                         const struct damage_rect *rects, int count,
+                         const uint16_t *pixels, uint32_t stride);
+
+/*
+ * ili9481_flush_rects_words() — Like ili9481_flush_rects(), but the pixel
+ *                               data is already expanded into bus words.
+ *
+ * `words` holds each rectangle's `w * h * 2` words (from
+ * gpio_expand_pixels()) back to back, in the same order as `rects`.
+ */
+void ili9481_flush_rects_words(struct gpio_bus *bus,
+                               const struct damage_rect *rects, int count,
+                               const struct gpio_word *words);
+
 /*
  * ili9481_power_off() — Send DISPOFF + SLPIN to the panel.
  */
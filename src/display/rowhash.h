@@ -0,0 +1,45 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * rowhash.h — Per-row change detection on the mmap'd source framebuffer
+ *
+ * Keeps a 64-bit hash of every source row from the previous scan.  A
+ * frame whose hashes all match needs no scaling and no bus traffic; a
+ * partly changed frame only needs the destination rows that sample the
+ * changed source rows (see scaler_dirty_rows()).
+ */
+
+#ifndef ROWHASH_H
+#define ROWHASH_H
+
+#include <stdint.h>
+
+struct rowhash {
+    uint32_t    rows;
+    uint64_t   *hash;       /* rows entries: hash from the last scan    */
+    uint8_t    *changed;    /* rows entries: 1 = differs from last scan */
+    int         valid;      /* 0 until the first scan                   */
+};
+
+/*
+ * rowhash_init() — Allocate state for a source of `rows` rows.
+ *
+ * Returns 0 on success, -1 on allocation failure.
+ */
+int rowhash_init(struct rowhash *rh, uint32_t rows);
+
+/*
+ * rowhash_scan() — Hash `row_bytes` bytes of each row of `src` (rows are
+ *                  `stride` bytes apart) and flag the rows that changed.
+ *
+ * Every row is reported as changed on the first scan.
+ * Returns the number of changed rows.
+ */
+uint32_t rowhash_scan(struct rowhash *rh, const uint8_t *src,
+                      uint32_t stride, uint32_t row_bytes);
+
+/*
+ * rowhash_free() — Release the hash tables.
+ */
+void rowhash_free(struct rowhash *rh);
+
+#endif /* ROWHASH_H */
@@ -0,0 +1,298 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * scaler.c — Index map construction and the box (area-averaging) filter
+ *
+ * The box filter is separable and fixed point:
+ *
+ *   1. unpack     — one source row into 64-bit words holding 8-bit R, G
+ *                   and B in separate 16-bit lanes
+ *   2. horizontal — per output column, xtaps Q8-weighted words summed
+ *                   in one multiply-add per tap (the weights of a column
+ *                   sum to 256, so no lane can carry into the next)
+ *                   → 8.8 fixed-point R, G, B planes (hrow)
+ *   3. vertical   — per output row, ytaps Q14-weighted hrows accumulated
+ *                   into acc, then packed to RGB565
+ *
+ * Steps 1 and 3 are straight-line loops over contiguous arrays and are
+ * left to the compiler's vectoriser (NEON / SSE2 at -O3).  A source row
+ * that straddles two output rows is unpacked and filtered once and
+ * reused from hrow.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scaler.h"
+
+#define XWEIGHT_ONE (1u << 8)       /* Q8: 255 × 256 still fits a 16-bit lane */
+#define YWEIGHT_ONE (1u << 14)      /* Q14 */
+
+/* ------------------------------------------------------------------ */
+/* Box filter taps                                                    */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Output pixel d covers source interval [d·n/m, (d+1)·n/m).  Working in
+ * units of 1/m keeps everything integral: output span [d·n, d·n + n),
+ * source pixel s spans [s·m, s·m + m).  Each tap's weight is the overlap
+ * divided by n, scaled to `one`; rounding residue goes to the heaviest
+ * tap so every output pixel's weights sum to exactly `one`.
+ */
+static void build_box_taps(uint32_t n, uint32_t m, uint32_t taps, uint32_t one,
+                           const uint32_t *start, uint16_t *weight)
+{
+    for (uint32_t d = 0; d < m; d++) {
+        uint64_t lo = (uint64_t)d * n;
+        uint64_t hi = lo + n;
+        uint16_t *w = &weight[(size_t)d * taps];
+        uint32_t sum = 0, heaviest = 0;
+
+        for (uint32_t t = 0; t < taps; t++) {
+            uint64_t slo = (uint64_t)(start[d] + t) * m;
+            uint64_t shi = slo + m;
+            uint64_t a = slo > lo ? slo : lo;
+            uint64_t b = shi < hi ? shi : hi;
+
+            w[t] = b > a ? (uint16_t)(((b - a) * one + n / 2) / n) : 0;
+            sum += w[t];
+            if (w[t] > w[heaviest])
+                heaviest = t;
+        }
+        w[heaviest] = (uint16_t)(w[heaviest] + one - sum);
+    }
+}
+
+static int alloc_box(struct scaler *sc)
+{
+    uint32_t sw = sc->src_w, sh = sc->src_h;
+    uint32_t dw = sc->dst_w, dh = sc->dst_h;
+
+    /* An output pixel spans n/m source pixels, so touches ≤ ⌈n/m⌉ + 1 */
+    sc->xtaps = (sw + dw - 1) / dw + 1;
+    sc->ytaps = (sh + dh - 1) / dh + 1;
+
+    sc->xweight = malloc((size_t)dw * sc->xtaps * sizeof(uint16_t));
+    sc->yweight = malloc((size_t)dh * sc->ytaps * sizeof(uint16_t));
+    /* Padded by xtaps so zero-weight taps past the right edge stay in bounds */
+    sc->lanes   = calloc((size_t)sw + sc->xtaps, sizeof(uint64_t));
+    sc->hrow    = malloc((size_t)dw * 3 * sizeof(uint16_t));
+    sc->acc     = malloc((size_t)dw * 3 * sizeof(uint32_t));
+    if (!sc->xweight || !sc->yweight || !sc->lanes || !sc->hrow || !sc->acc)
+        return -1;
+
+    build_box_taps(sw, dw, sc->xtaps, XWEIGHT_ONE, sc->xmap, sc->xweight);
+    build_box_taps(sh, dh, sc->ytaps, YWEIGHT_ONE, sc->ymap, sc->yweight);
+
+    /* Rows with identical taps produce identical output */
+    for (uint32_t dy = 1; dy < dh; dy++) {
+        sc->row_dup[dy] = sc->ymap[dy] == sc->ymap[dy - 1] &&
+            memcmp(&sc->yweight[(size_t)dy * sc->ytaps],
+                   &sc->yweight[(size_t)(dy - 1) * sc->ytaps],
+                   sc->ytaps * sizeof(uint16_t)) == 0;
+    }
+
+    sc->hrow_src = UINT32_MAX;
+    sc->last_dy  = UINT32_MAX;
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Init / free                                                        */
+/* ------------------------------------------------------------------ */
+
+int scaler_init(struct scaler *sc,
+                uint32_t src_w, uint32_t src_h,
+                uint32_t dst_w, uint32_t dst_h,
+                enum scale_filter filter)
+{
+    if (sc->xmap && sc->src_w == src_w && sc->src_h == src_h &&
+        sc->dst_w == dst_w && sc->dst_h == dst_h && sc->filter == filter)
+        return 0;
+
+    scaler_free(sc);
+
+    sc->xmap    = malloc((size_t)dst_w * sizeof(uint32_t));
+    sc->ymap    = malloc((size_t)dst_h * sizeof(uint32_t));
+    sc->row_dup = malloc((size_t)dst_h);
+    if (!sc->xmap || !sc->ymap || !sc->row_dup) {
+        scaler_free(sc);
+        return -1;
+    }
+
+    sc->src_w  = src_w;
+    sc->src_h  = src_h;
+    sc->dst_w  = dst_w;
+    sc->dst_h  = dst_h;
+    sc->filter = filter;
+
+    /* 64-bit intermediates: 4K sources × large panels overflow 32 bits */
+    for (uint32_t dx = 0; dx < dst_w; dx++)
+        sc->xmap[dx] = (uint32_t)((uint64_t)dx * src_w / dst_w);
+
+    for (uint32_t dy = 0; dy < dst_h; dy++) {
+        sc->ymap[dy] = (uint32_t)((uint64_t)dy * src_h / dst_h);
+        sc->row_dup[dy] = dy > 0 && sc->ymap[dy] == sc->ymap[dy - 1];
+    }
+
+    if (filter == SCALE_FILTER_BOX && alloc_box(sc) < 0) {
+        scaler_free(sc);
+        return -1;
+    }
+
+    return 0;
+}
+
+uint32_t scaler_dirty_rows(const struct scaler *sc, const uint8_t *src_changed,
+                           uint8_t *dst_dirty)
+{
+    uint32_t count = 0;
+
+    for (uint32_t dy = 0; dy < sc->dst_h; dy++) {
+        uint8_t dirty = src_changed[sc->ymap[dy]];
+
+        if (sc->filter == SCALE_FILTER_BOX) {
+            const uint16_t *w = &sc->yweight[(size_t)dy * sc->ytaps];
+            for (uint32_t t = 1; t < sc->ytaps && !dirty; t++)
+                dirty = w[t] && src_changed[sc->ymap[dy] + t];
+        }
+        dst_dirty[dy] = dirty;
+        count += dirty;
+    }
+    return count;
+}
+
+void scaler_free(struct scaler *sc)
+{
+    free(sc->xmap);
+    free(sc->ymap);
+    free(sc->row_dup);
+    free(sc->xweight);
+    free(sc->yweight);
+    free(sc->lanes);
+    free(sc->hrow);
+    free(sc->acc);
+    memset(sc, 0, sizeof(*sc));
+}
+
+/* ------------------------------------------------------------------ */
+/* Box filter passes                                                  */
+/* ------------------------------------------------------------------ */
+
+/* Bring a channel of `len` bits to 8 bits (MSB-aligned) */
+static inline uint64_t chan8(uint32_t px, uint32_t off, uint32_t len)
+{
+    uint32_t v = (px >> off) & ((1u << len) - 1);
+    return len >= 8 ? v >> (len - 8) : v << (8 - len);
+}
+
+/* R in bits 0–7, G in 16–23, B in 32–39 */
+#define LANES(r, g, b)  ((uint64_t)(r) | ((uint64_t)(g) << 16) | ((uint64_t)(b) << 32))
+
+static void __attribute__((optimize("O3")))
+unpack_row(uint64_t *dst, const uint8_t *row, uint32_t count,
+           const struct scaler_format *fmt)
+{
+    if (fmt->bpp == 16) {
+        const uint16_t *s = (const uint16_t *)row;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t px = s[i];
+            dst[i] = LANES(((px >> 8) & 0xF8) | (px >> 13),
+                           ((px >> 3) & 0xFC) | ((px >> 9) & 0x03),
+                           ((px << 3) & 0xF8) | ((px >> 2) & 0x07));
+        }
+    } else if (fmt->r_len == 8 && fmt->g_len == 8 && fmt->b_len == 8) {
+        const uint32_t *s = (const uint32_t *)row;
+        const uint32_t ro = fmt->r_off, go = fmt->g_off, bo = fmt->b_off;
+        for (uint32_t i = 0; i < count; i++)
+            dst[i] = LANES((s[i] >> ro) & 0xFF, (s[i] >> go) & 0xFF,
+                           (s[i] >> bo) & 0xFF);
+    } else {
+        const uint32_t *s = (const uint32_t *)row;
+        for (uint32_t i = 0; i < count; i++)
+            dst[i] = LANES(chan8(s[i], fmt->r_off, fmt->r_len),
+                           chan8(s[i], fmt->g_off, fmt->g_len),
+                           chan8(s[i], fmt->b_off, fmt->b_len));
+    }
+}
+
+/* Unpack + horizontally filter one source row into sc->hrow */
+static void filter_row_h(struct scaler *sc, const uint8_t *row,
+                         const struct scaler_format *fmt)
+{
+    const uint32_t dw = sc->dst_w, taps = sc->xtaps;
+    const uint64_t *px = sc->lanes;
+    uint16_t *hr = sc->hrow;
+    uint16_t *hg = hr + dw;
+    uint16_t *hb = hg + dw;
+
+    unpack_row(sc->lanes, row, sc->src_w, fmt);
+
+    for (uint32_t dx = 0; dx < dw; dx++) {
+        const uint16_t *w = &sc->xweight[(size_t)dx * taps];
+        const uint64_t *p = &px[sc->xmap[dx]];
+        uint64_t sum = 0;
+
+        /* 8-bit × Q8 → 8.8 in each lane */
+        for (uint32_t t = 0; t < taps; t++)
+            sum += p[t] * w[t];
+
+        hr[dx] = (uint16_t)sum;
+        hg[dx] = (uint16_t)(sum >> 16);
+        hb[dx] = (uint16_t)(sum >> 32);
+    }
+}
+
+static void __attribute__((optimize("O3")))
+accumulate(uint32_t *acc, const uint16_t *h, uint32_t w, uint32_t count, int first)
+{
+    if (first) {
+        for (uint32_t i = 0; i < count; i++)
+            acc[i] = (uint32_t)h[i] * w;
+    } else {
+        for (uint32_t i = 0; i < count; i++)
+            acc[i] += (uint32_t)h[i] * w;
+    }
+}
+
+static void __attribute__((optimize("O3")))
+pack_row(uint16_t *dst, const uint32_t *acc, uint32_t count)
+{
+    const uint32_t *ar = acc, *ag = acc + count, *ab = ag + count;
+
+    /* acc is 8.8 × Q14; the top 5/6 bits of the 8-bit value remain */
+    for (uint32_t i = 0; i < count; i++) {
+        dst[i] = (uint16_t)(((ar[i] >> 25) << 11) |
+                            ((ag[i] >> 24) << 5)  |
+                             (ab[i] >> 25));
+    }
+}
+
+void scaler_box_row(struct scaler *sc, uint32_t dy,
+                    const uint8_t *src, uint32_t stride,
+                    const struct scaler_format *fmt, uint16_t *dst)
+{
+    const uint16_t *w = &sc->yweight[(size_t)dy * sc->ytaps];
+    const uint32_t n = sc->dst_w * 3;
+    int first = 1;
+
+    /* hrow carries over only between consecutive rows of one frame */
+    if (dy == 0 || dy != sc->last_dy + 1)
+        sc->hrow_src = UINT32_MAX;
+    sc->last_dy = dy;
+
+    for (uint32_t t = 0; t < sc->ytaps; t++) {
+        uint32_t sy = sc->ymap[dy] + t;
+
+        if (!w[t])
+            continue;
+        if (sy != sc->hrow_src) {
+            filter_row_h(sc, src + (size_t)sy * stride, fmt);
+            sc->hrow_src = sy;
+        }
+        accumulate(sc->acc, sc->hrow, w[t], n, first);
+        first = 0;
+    }
+
+    pack_row(dst, sc->acc, sc->dst_w);
+}
@@ -0,0 +1,105 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * scaler.h — Precomputed index maps and filter taps for frame scaling
+ *
+ * Built once per source/destination geometry so the per-frame loops do
+ * table lookups instead of a divide per pixel, and can memcpy destination
+ * rows that are identical to the row above.
+ *
+ * Two filters are available:
+ *   nearest — one source pixel per destination pixel (xmap/ymap)
+ *   box     — area averaging: every source pixel that a destination
+ *             pixel covers contributes in proportion to the covered
+ *             area.  Keeps 1–2 px desktop text legible when a 720p or
+ *             1080p mode is shrunk onto a 480×320 panel.
+ */
+
+#ifndef SCALER_H
+#define SCALER_H
+
+#include <stdint.h>
+
+enum scale_filter {
+    SCALE_FILTER_NEAREST = 0,
+    SCALE_FILTER_BOX,
+};
+
+/*
+ * Source pixel layout for the box filter: 16bpp is always RGB565; 32bpp
+ * channels are described by their fb_var_screeninfo offset and length.
+ */
+struct scaler_format {
+    uint32_t    bpp;
+    uint32_t    r_off, r_len;
+    uint32_t    g_off, g_len;
+    uint32_t    b_off, b_len;
+};
+
+struct scaler {
+    uint32_t    src_w;
+    uint32_t    src_h;
+    uint32_t    dst_w;
+    uint32_t    dst_h;
+    enum scale_filter filter;
+    uint32_t   *xmap;       /* dst_w entries: source column for each dx */
+    uint32_t   *ymap;       /* dst_h entries: source row for each dy    */
+    uint8_t    *row_dup;    /* dst_h entries: 1 = same output as dy-1   */
+
+    /* Box filter only: weights per output pixel, first tap at xmap/ymap */
+    uint32_t    xtaps;
+    uint32_t    ytaps;
+    uint16_t   *xweight;    /* dst_w × xtaps, Q8                        */
+    uint16_t   *yweight;    /* dst_h × ytaps, Q14                       */
+    uint64_t   *lanes;      /* one source row, R/G/B in 16-bit lanes    */
+    uint16_t   *hrow;       /* horizontally filtered row, 8.8 R, G, B   */
+    uint32_t   *acc;        /* vertical accumulator, R, G, B            */
+    uint32_t    hrow_src;   /* source row held in hrow                  */
+    uint32_t    last_dy;    /* previous scaler_box_row() output row     */
+};
+
+/*
+ * scaler_init() — Build the maps for scaling `src_w × src_h` to
+ *                 `dst_w × dst_h` with `filter`.
+ *
+ * `sc` must be zeroed before the first call.  Calling it again (e.g. after
+ * a video mode change or a filter switch) rebuilds the maps; it is a
+ * no-op if nothing changed.
+ *
+ * Returns 0 on success, -1 on allocation failure (maps are then freed).
+ */
+int scaler_init(struct scaler *sc,
+                uint32_t src_w, uint32_t src_h,
+                uint32_t dst_w, uint32_t dst_h,
+                enum scale_filter filter);
+
+/*
+ * scaler_box_row() — Produce destination row `dy` (RGB565, host order)
+ *                    with the box filter.
+ *
+ * `src` is the top-left source pixel and `stride` the source line length
+ * in bytes.  Rows are cheapest when requested in ascending order within a
+ * frame: a source row shared by two output rows is filtered only once.
+ * Only valid if `sc` was initialised with SCALE_FILTER_BOX.
+ */
+void scaler_box_row(struct scaler *sc, uint32_t dy,
+                    const uint8_t *src, uint32_t stride,
+                    const struct scaler_format *fmt, uint16_t *dst);
+
+/*
+ * scaler_dirty_rows() — Work out which destination rows sample a changed
+ *                       source row.
+ *
+ * `src_changed` has src_h entries, `dst_dirty` dst_h; a row is dirty (1)
+ * if any source row contributing to it (one for nearest, every row with
+ * a non-zero weight for box) is flagged.
+ * Returns the number of dirty destination rows.
+ */
+uint32_t scaler_dirty_rows(const struct scaler *sc, const uint8_t *src_changed,
+                           uint8_t *dst_dirty);
+
+/*
+ * scaler_free() — Release the maps; `sc` may be re-initialised afterwards.
+ */
+void scaler_free(struct scaler *sc);
+
+#endif /* SCALER_H */
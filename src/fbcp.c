@@ -12,6 +12,8 @@
  * injects events via uinput.  Compiled when ENABLE_TOUCH=1.
  */
 
+#define _GNU_SOURCE     /* posix_memalign, mlock */
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -23,14 +25,21 @@
 #include <errno.h>
 #include <signal.h>
 #include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
 #include <sys/mman.h>
 #include <sys/ioctl.h>
 #include <linux/fb.h>
 #include <linux/spi/spidev.h>
 #include <linux/gpio.h>
 
+#include "display/scaler.h"
+#include "display/rowhash.h"
+#include "display/damage.h"
+#include "core/pacer.h"
+
 #ifdef ENABLE_TOUCH
-#include <pthread.h>
 #include "touch/xpt2046.h"
 #include "touch/uinput_touch.h"
 #endif
@@ -39,7 +48,19 @@
 #define DISPLAY_H  320
 #define GPIO_DC    24
 #define GPIO_RST   25
-#define SPI_CHUNK  4096
+
+/* spidev defaults: bytes per SPI_IOC_MESSAGE (module param "bufsiz") */
+#define SPI_BUFSIZ_PATH     "/sys/module/spidev/parameters/bufsiz"
+#define SPI_BUFSIZ_DEFAULT  4096
+#define SPI_SEGS_MAX        64      /* spi_ioc_transfer segments per message */
+
+/*
+ * Partial updates: damage cell size, and what one more CASET/PASET/RAMWR
+ * window costs (22 padded bytes plus the DC toggles and separate SPI
+ * messages), as the bus time of this many pixels at 12–16 MHz.
+ */
+#define DAMAGE_TILE         16
+#define WINDOW_COST_PX      256
 
 enum scale_mode {
     SCALE_STRETCH = 0,
@@ -52,11 +73,15 @@ struct runtime_config {
     char spi_dev[128];
     char gpiochip[128];
     int fps;
+    int idle_fps;
+    unsigned idle_after;
     int test_pattern;
+    int tx_thread;
     uint32_t display_speed_hz;
     uint32_t render_width;
     uint32_t render_height;
     enum scale_mode scale_mode;
+    enum scale_filter scale_filter;
 #ifdef ENABLE_TOUCH
     int touch_enabled;
     char touch_dev[128];
@@ -77,8 +102,10 @@ struct content_rect {
 };
 
 static volatile int g_running = 1;
+static struct pacer g_pacer;
 static int spi_fd = -1, dc_fd = -1, rst_fd = -1;
 static uint32_t spi_speed = 12000000;  /* default 12 MHz */
+static uint32_t spi_bufsiz = SPI_BUFSIZ_DEFAULT;
 
 static void sig_handler(int s) { (void)s; g_running = 0; }
 
@@ -124,6 +151,13 @@ static enum scale_mode parse_scale_mode(const char *value)
     return SCALE_FIT;
 }
 
+static enum scale_filter parse_scale_filter(const char *value)
+{
+    if (!strcasecmp(value, "box") || !strcasecmp(value, "area"))
+        return SCALE_FILTER_BOX;
+    return SCALE_FILTER_NEAREST;
+}
+
 static void config_defaults(struct runtime_config *cfg)
 {
     memset(cfg, 0, sizeof(*cfg));
@@ -132,10 +166,14 @@ static void config_defaults(struct runtime_config *cfg)
     copy_string(cfg->spi_dev, sizeof(cfg->spi_dev), "/dev/spidev0.0");
     copy_string(cfg->gpiochip, sizeof(cfg->gpiochip), "/dev/gpiochip0");
     cfg->fps = 15;
+    cfg->idle_fps = 5;
+    cfg->idle_after = 60;
     cfg->display_speed_hz = 12000000;
     cfg->render_width = 720;
     cfg->render_height = 480;
     cfg->scale_mode = SCALE_FIT;
+    cfg->scale_filter = SCALE_FILTER_NEAREST;
+    cfg->tx_thread = 1;
 #ifdef ENABLE_TOUCH
     cfg->touch_enabled = 1;
     copy_string(cfg->touch_dev, sizeof(cfg->touch_dev), "/dev/spidev0.1");
@@ -160,6 +198,11 @@ static void apply_config_kv(struct runtime_config *cfg, const char *key, const c
         cfg->fps = atoi(value);
         if (cfg->fps < 1) cfg->fps = 1;
         if (cfg->fps > 60) cfg->fps = 60;
+    } else if (!strcmp(key, "idle_fps")) {
+        cfg->idle_fps = atoi(value);
+        if (cfg->idle_fps < 1) cfg->idle_fps = 1;
+    } else if (!strcmp(key, "idle_after")) {
+        cfg->idle_after = (unsigned)atoi(value);
     } else if (!strcmp(key, "display_speed")) {
         cfg->display_speed_hz = (uint32_t)atoi(value) * 1000000U;
     } else if (!strcmp(key, "render_width")) {
@@ -168,6 +211,10 @@ static void apply_config_kv(struct runtime_config *cfg, const char *key, const c
         cfg->render_height = (uint32_t)atoi(value);
     } else if (!strcmp(key, "scale_mode")) {
         cfg->scale_mode = parse_scale_mode(value);
+    } else if (!strcmp(key, "scale_filter")) {
+        cfg->scale_filter = parse_scale_filter(value);
+    } else if (!strcmp(key, "tx_thread")) {
+        cfg->tx_thread = parse_bool(value);
 #ifdef ENABLE_TOUCH
     } else if (!strcmp(key, "enable_touch")) {
         cfg->touch_enabled = parse_bool(value);
@@ -272,6 +319,37 @@ static inline void gpio_set(int fd, int v)
 }
 
 /* ── SPI ─────────────────────────────────────────────────────────── */
+
+/*
+ * Transfer engine: spi_queue() collects spi_ioc_transfer segments and
+ * spi_flush() submits them with a single SPI_IOC_MESSAGE(n).  spidev
+ * rejects a message whose tx bytes exceed its bufsiz, so the queue
+ * flushes itself whenever the next byte would not fit; raising bufsiz
+ * (spidev.bufsiz=65536 on the kernel command line) cuts a full frame
+ * from 75 ioctls to 5.  DC is a separate GPIO, so callers flush before
+ * toggling it.
+ */
+static struct spi_ioc_transfer spi_segs[SPI_SEGS_MAX];
+static unsigned spi_nsegs;
+static uint32_t spi_queued;     /* tx bytes in spi_segs */
+static uint8_t spi_scratch[256];
+static uint32_t spi_scratch_used;
+
+static uint32_t spi_query_bufsiz(void)
+{
+    FILE *fp = fopen(SPI_BUFSIZ_PATH, "r");
+    unsigned long v = 0;
+
+    if (fp) {
+        if (fscanf(fp, "%lu", &v) != 1)
+            v = 0;
+        fclose(fp);
+    }
+    if (!v || v > (1UL << 22))
+        v = SPI_BUFSIZ_DEFAULT;
+    return (uint32_t)v;
+}
+
 static int spi_init(const char *dev)
 {
     spi_fd = open(dev, O_RDWR);
@@ -280,18 +358,65 @@ static int spi_init(const char *dev)
     ioctl(spi_fd, SPI_IOC_WR_MODE, &m);
     ioctl(spi_fd, SPI_IOC_WR_BITS_PER_WORD, &b);
     ioctl(spi_fd, SPI_IOC_WR_MAX_SPEED_HZ, &spi_speed);
+
+    spi_bufsiz = spi_query_bufsiz();
+    fprintf(stderr, "fbcp: spidev bufsiz %u bytes per message%s\n", spi_bufsiz,
+            spi_bufsiz <= SPI_BUFSIZ_DEFAULT ? " (spidev.bufsiz=65536 allows fewer ioctls)" : "");
     return 0;
 }
 
-static void spi_tx(const uint8_t *buf, uint32_t len)
+static void spi_flush(void)
 {
-    struct spi_ioc_transfer t;
-    memset(&t, 0, sizeof(t));
-    t.tx_buf = (uintptr_t)buf;
-    t.len = len;
-    t.speed_hz = spi_speed;
-    t.bits_per_word = 8;
-    ioctl(spi_fd, SPI_IOC_MESSAGE(1), &t);
+    if (!spi_nsegs)
+        return;
+
+    if (ioctl(spi_fd, SPI_IOC_MESSAGE(spi_nsegs), spi_segs) < 0) {
+        static int warned;
+        if (!warned++)
+            fprintf(stderr, "fbcp: SPI_IOC_MESSAGE(%u, %u bytes): %s\n",
+                    spi_nsegs, spi_queued, strerror(errno));
+    }
+    spi_nsegs = 0;
+    spi_queued = 0;
+    spi_scratch_used = 0;
+}
+
+/* Scratch space for small queued payloads, valid until the next flush */
+static uint8_t *spi_alloc(uint32_t n)
+{
+    if (spi_scratch_used + n > sizeof(spi_scratch))
+        spi_flush();
+    uint8_t *p = spi_scratch + spi_scratch_used;
+    spi_scratch_used += n;
+    return p;
+}
+
+/* Append `len` bytes at `buf` to the message; `buf` must stay valid until flushed */
+static void spi_queue(const uint8_t *buf, size_t len)
+{
+    while (len) {
+        if (spi_queued == spi_bufsiz || spi_nsegs == SPI_SEGS_MAX)
+            spi_flush();
+
+        uint32_t c = spi_bufsiz - spi_queued;
+        if (c > len)
+            c = (uint32_t)len;
+
+        struct spi_ioc_transfer *last = spi_nsegs ? &spi_segs[spi_nsegs - 1] : NULL;
+        if (last && last->tx_buf + last->len == (uintptr_t)buf) {
+            last->len += c;     /* contiguous with the previous segment */
+        } else {
+            struct spi_ioc_transfer *t = &spi_segs[spi_nsegs++];
+            memset(t, 0, sizeof(*t));
+            t->tx_buf = (uintptr_t)buf;
+            t->len = c;
+            t->speed_hz = spi_speed;
+            t->bits_per_word = 8;
+        }
+        spi_queued += c;
+        buf += c;
+        len -= c;
+    }
 }
 
 /*
@@ -299,26 +424,58 @@ static void spi_tx(const uint8_t *buf, uint32_t len)
  *   Command byte 0xAB  is sent as  DC=0, SPI bytes: 0x00 0xAB
  *   Data byte    0xCD  is sent as  DC=1, SPI bytes: 0x00 0xCD
  * Pixel data after RAMWR is sent as raw bytes (no padding).
+ *
+ * The lcd_* helpers build a command stream on the transfer engine: bytes
+ * are queued and only submitted when DC has to change or at lcd_sync(),
+ * so each run of same-DC bytes is one SPI message.  The DC level is
+ * cached and written only when it actually changes, and lcd_set_window()
+ * skips CASET or PASET when the panel already holds that range — the
+ * common case for the full-width bands of a typical update.
+ * lcd_begin_write() goes further and sends no command at all when the
+ * rows follow on from the pixel write still open in the same columns.
  */
+static int dc_level = -1;       /* unknown until the first write */
+static uint32_t lcd_caset = UINT32_MAX, lcd_paset = UINT32_MAX;   /* start<<16 | end */
+static uint32_t lcd_ram_cols = UINT32_MAX;  /* columns of the open RAMWR, if any */
+static uint16_t lcd_ram_y;                  /* next row it will write */
+
+static void lcd_dc(int v)
+{
+    if (v == dc_level)
+        return;
+    spi_flush();    /* bytes queued under the old level go first */
+    gpio_set(dc_fd, v);
+    dc_level = v;
+}
+
+/* Submit everything queued, e.g. before a delay the panel must see */
+static void lcd_sync(void)
+{
+    spi_flush();
+}
+
 static void lcd_cmd(uint8_t c)
 {
-    uint8_t buf[2] = { 0x00, c };
-    gpio_set(dc_fd, 0);
-    spi_tx(buf, 2);
+    lcd_ram_cols = UINT32_MAX;      /* any command ends a pixel write */
+    lcd_dc(0);
+    uint8_t *p = spi_alloc(2);
+    p[0] = 0x00;
+    p[1] = c;
+    spi_queue(p, 2);
 }
 
 static void lcd_data16(const uint8_t *d, size_t n)
 {
     /* Each data byte is expanded to 2 bytes: 0x00, byte */
-    uint8_t buf[128];  /* max 64 data bytes at a time */
-    gpio_set(dc_fd, 1);
+    lcd_dc(1);
     while (n > 0) {
-        size_t batch = n > 64 ? 64 : n;
+        size_t batch = n > 64 ? 64 : n;    /* max 128 scratch bytes at a time */
+        uint8_t *buf = spi_alloc((uint32_t)batch * 2);
         for (size_t i = 0; i < batch; i++) {
             buf[i*2]     = 0x00;
             buf[i*2 + 1] = d[i];
         }
-        spi_tx(buf, batch * 2);
+        spi_queue(buf, batch * 2);
         d += batch;
         n -= batch;
     }
@@ -326,11 +483,14 @@ static void lcd_data16(const uint8_t *d, size_t n)
 
 static void lcd_d8(uint8_t v) { lcd_data16(&v, 1); }
 
-/* Raw data (no 16-bit padding) — for pixel writes */
+/*
+ * Raw data (no 16-bit padding) — for pixel writes.  Queued like the rest
+ * of the stream: `d` must stay valid until lcd_sync().
+ */
 static void lcd_raw(const uint8_t *d, size_t n)
 {
-    gpio_set(dc_fd, 1);
-    spi_tx(d, n);
+    lcd_dc(1);
+    spi_queue(d, n);
 }
 
 /* ── ILI9486 init (MPI3501 / tft35a from LCD-show) ───────────────── */
@@ -340,6 +500,7 @@ static void ili9486_init(void)
     gpio_set(rst_fd, 1); usleep(50000);
     gpio_set(rst_fd, 0); usleep(50000);
     gpio_set(rst_fd, 1); usleep(150000);
+    lcd_caset = lcd_paset = UINT32_MAX;    /* reset to the full panel */
 
     fprintf(stderr, "  Sending init sequence (16-bit register width)...\n");
 
@@ -360,21 +521,47 @@ static void ili9486_init(void)
     lcd_cmd(0x3A); lcd_d8(0x55);           /* 16-bit color */
 
     fprintf(stderr, "  Sleep out (0x11)...\n");
-    lcd_cmd(0x11); usleep(150000);
+    lcd_cmd(0x11); lcd_sync(); usleep(150000);
 
     lcd_cmd(0x36); lcd_d8(0x28);           /* landscape */
+    lcd_sync();
     usleep(255000);
 
     fprintf(stderr, "  Display on (0x29)...\n");
-    lcd_cmd(0x29); usleep(50000);
+    lcd_cmd(0x29); lcd_sync(); usleep(50000);
 }
 
 static void lcd_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
-    lcd_cmd(0x2A);
-    { uint8_t d[]={x0>>8,x0&0xFF,x1>>8,x1&0xFF}; lcd_data16(d,4); }
-    lcd_cmd(0x2B);
-    { uint8_t d[]={y0>>8,y0&0xFF,y1>>8,y1&0xFF}; lcd_data16(d,4); }
+    uint32_t caset = (uint32_t)x0 << 16 | x1, paset = (uint32_t)y0 << 16 | y1;
+
+    if (caset != lcd_caset) {
+        lcd_cmd(0x2A);
+        { uint8_t d[]={x0>>8,x0&0xFF,x1>>8,x1&0xFF}; lcd_data16(d,4); }
+        lcd_caset = caset;
+    }
+    if (paset != lcd_paset) {
+        lcd_cmd(0x2B);
+        { uint8_t d[]={y0>>8,y0&0xFF,y1>>8,y1&0xFF}; lcd_data16(d,4); }
+        lcd_paset = paset;
+    }
+}
+
+/*
+ * Start writing `h` rows at (x0, y0) in columns x0..x1.  The window runs
+ * to the bottom of the panel, so a following band in the same columns
+ * can carry on with the same RAMWR.
+ */
+static void lcd_begin_write(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t h)
+{
+    uint32_t cols = (uint32_t)x0 << 16 | x1;
+
+    if (cols != lcd_ram_cols || y0 != lcd_ram_y) {
+        lcd_set_window(x0, y0, x1, DISPLAY_H - 1);
+        lcd_cmd(0x2C);  /* RAMWR */
+        lcd_ram_cols = cols;
+    }
+    lcd_ram_y = y0 + h;
 }
 
 /* Fill entire screen with a solid color (for testing) */
@@ -389,24 +576,160 @@ static void lcd_fill(uint16_t color)
         row[i*2]   = hi;
         row[i*2+1] = lo;
     }
-    gpio_set(dc_fd, 1);
     for (int y = 0; y < DISPLAY_H; y++)
-        spi_tx(row, sizeof(row));
+        lcd_raw(row, sizeof(row));      /* several rows per message */
+    lcd_sync();
+}
+
+/* ── SPI submission thread ───────────────────────────────────────── */
+
+/*
+ * After init, all panel traffic runs on a submission thread fed by a
+ * bounded ring of jobs, so capture and scaling of frame N+1 overlap the
+ * transfer of frame N.  A job is one rectangle: a window (CASET, PASET,
+ * RAMWR — none if it continues the previous write) plus its pixels,
+ * which are not copied: each row is queued on the transfer
+ * engine straight from the frame loop's page-aligned, mlock()ed
+ * wire-order image, and contiguous rows merge into one segment.  The
+ * thread keeps queueing while jobs are waiting and only submits when the
+ * engine is full or the ring runs dry.
+ *
+ * `head` is only written by the frame loop and `tail` only by the tx
+ * thread; release/acquire on those two counters is the sole
+ * synchronisation for job contents.  `tail` only passes a job once its
+ * pixels are on the wire, so the frame loop may reuse an image as soon
+ * as tx_sent() has reached the last job that referenced it.  `ready`
+ * wakes the tx thread and `space` counts free slots.  The SPI engine and
+ * DC belong to the tx thread once it runs.  With the thread disabled,
+ * tx_put() runs each job in place.
+ */
+#define TX_JOBS     256         /* power of two */
+
+struct tx_job {
+    const uint16_t *img;        /* panel-sized wire-order image */
+    uint16_t        x, y, w, h;
+};
+
+static struct {
+    int             active;
+    pthread_t       tid;
+    struct tx_job   jobs[TX_JOBS];
+    atomic_uint     head;       /* next job to fill  (frame loop)       */
+    atomic_uint     tail;       /* first job not yet on the wire        */
+    sem_t           ready;      /* posted once per queued job           */
+    sem_t           space;      /* free slots                           */
+} g_tx;
+
+/* Queue one job on the command stream; lcd_sync() puts it on the wire */
+static void tx_run(const struct tx_job *j)
+{
+    lcd_begin_write(j->x, j->y, j->x + j->w - 1, j->h);
+    for (uint16_t r = 0; r < j->h; r++)
+        lcd_raw((const uint8_t *)(j->img + (size_t)(j->y + r) * DISPLAY_W + j->x),
+                (size_t)j->w * 2);
 }
 
-static void lcd_push(const uint16_t *buf, size_t npx)
+/* Submit the queued jobs up to `tail` and hand their slots back */
+static void tx_release(unsigned *done, unsigned tail)
 {
-    lcd_set_window(0, 0, DISPLAY_W - 1, DISPLAY_H - 1);
-    lcd_cmd(0x2C);
-    gpio_set(dc_fd, 1);
-    const uint8_t *p = (const uint8_t *)buf;
-    size_t rem = npx * 2;
-    while (rem) {
-        size_t c = rem > SPI_CHUNK ? SPI_CHUNK : rem;
-        spi_tx(p, c);
-        p += c;
-        rem -= c;
+    lcd_sync();
+    atomic_store_explicit(&g_tx.tail, tail, memory_order_release);
+    for (; *done != tail; (*done)++)
+        sem_post(&g_tx.space);
+}
+
+static void *tx_thread_fn(void *arg)
+{
+    unsigned tail = 0, done = 0;
+
+    (void)arg;
+
+    for (;;) {
+        if (sem_trywait(&g_tx.ready) < 0) {
+            tx_release(&done, tail);        /* ring ran dry */
+            if (sem_wait(&g_tx.ready) < 0)
+                continue;   /* EINTR — tx_stop() posts once more */
+        }
+
+        unsigned head = atomic_load_explicit(&g_tx.head, memory_order_acquire);
+        if (tail == head)
+            break;      /* stop request */
+
+        tx_run(&g_tx.jobs[tail & (TX_JOBS - 1)]);
+        tail++;
+    }
+    tx_release(&done, tail);
+    return NULL;
+}
+
+/* Start the tx thread; without it, or if it cannot be created, jobs run inline */
+static void tx_start(int threaded)
+{
+    atomic_init(&g_tx.head, 0);
+    atomic_init(&g_tx.tail, 0);
+    if (!threaded)
+        return;
+
+    sem_init(&g_tx.ready, 0, 0);
+    sem_init(&g_tx.space, 0, TX_JOBS);
+    if (pthread_create(&g_tx.tid, NULL, tx_thread_fn, NULL) != 0) {
+        perror("pthread_create (tx)");
+        sem_destroy(&g_tx.ready);
+        sem_destroy(&g_tx.space);
+        return;
+    }
+    g_tx.active = 1;
+}
+
+/* Send everything still queued and stop the tx thread */
+static void tx_stop(void)
+{
+    if (!g_tx.active)
+        return;
+
+    /* Extra post with no job behind it tells the tx thread to exit */
+    sem_post(&g_tx.ready);
+    pthread_join(g_tx.tid, NULL);
+    sem_destroy(&g_tx.ready);
+    sem_destroy(&g_tx.space);
+    g_tx.active = 0;
+}
+
+/* Jobs handed to the tx thread so far; compare against tx_sent() */
+static unsigned tx_queued(void)
+{
+    return atomic_load_explicit(&g_tx.head, memory_order_relaxed);
+}
+
+static unsigned tx_sent(void)
+{
+    return atomic_load_explicit(&g_tx.tail, memory_order_acquire);
+}
+
+/*
+ * Queue the w×h rectangle at (x, y) of `img`, waiting for the tx thread
+ * if the ring is full.  `img` must not change until tx_sent() has passed
+ * this job.
+ */
+static void tx_rect(const uint16_t *img, uint16_t x, uint16_t y,
+                    uint16_t w, uint16_t h)
+{
+    unsigned head = tx_queued();
+    struct tx_job *j = &g_tx.jobs[head & (TX_JOBS - 1)];
+
+    if (g_tx.active)
+        while (sem_wait(&g_tx.space) < 0)
+            ;
+    *j = (struct tx_job){ img, x, y, w, h };
+
+    if (!g_tx.active) {
+        tx_run(j);
+        lcd_sync();
+        atomic_store_explicit(&g_tx.tail, head + 1, memory_order_relaxed);
     }
+    atomic_store_explicit(&g_tx.head, head + 1, memory_order_release);
+    if (g_tx.active)
+        sem_post(&g_tx.ready);
 }
 
 /* ── Framebuffer ─────────────────────────────────────────────────── */
@@ -431,6 +754,19 @@ static inline uint16_t to565(uint32_t px, uint32_t ro, uint32_t go, uint32_t bo)
                       ((px >> (bo+8-5-11)) & 0x001F));
 }
 
+/* Zeroed, page-aligned and locked panel image that spidev sends from */
+static uint16_t *image_alloc(size_t npx)
+{
+    void *p;
+
+    if (posix_memalign(&p, (size_t)sysconf(_SC_PAGESIZE), npx * 2) != 0)
+        return NULL;
+    memset(p, 0, npx * 2);
+    if (mlock(p, npx * 2) < 0)
+        fprintf(stderr, "fbcp: mlock panel image: %s\n", strerror(errno));
+    return p;
+}
+
 /* ── Touch thread (optional) ─────────────────────────────────────── */
 #ifdef ENABLE_TOUCH
 struct touch_args {
@@ -440,6 +776,7 @@ struct touch_args {
     uint16_t        height;
     struct content_rect content;
     volatile int   *running;
+    struct pacer   *pacer;
     int             swap_xy;
     int             invert_x;
     int             invert_y;
@@ -548,6 +885,7 @@ static void *touch_thread_fn(void *arg)
             pen_up_count = 0;
             was_down = 1;
             uinput_touch_report(ut, 1, x, y);
+            pacer_kick(ta->pacer);  /* back to full rate if idling */
         } else {
             if (was_down) {
                 pen_up_count++;
@@ -598,6 +936,11 @@ int main(int argc, char **argv)
             cfg.fps = atoi(argv[i] + 6);
             if (cfg.fps < 1) cfg.fps = 1;
             if (cfg.fps > 60) cfg.fps = 60;
+        } else if (!strncmp(argv[i],"--idle-fps=",11)) {
+            cfg.idle_fps = atoi(argv[i] + 11);
+            if (cfg.idle_fps < 1) cfg.idle_fps = 1;
+        } else if (!strncmp(argv[i],"--idle-after=",13)) {
+            cfg.idle_after = (unsigned)atoi(argv[i] + 13);
         } else if (!strncmp(argv[i],"--spi-speed=",12)) {
             cfg.display_speed_hz = (uint32_t)(atoi(argv[i] + 12) * 1000000U);
         } else if (!strncmp(argv[i],"--render-width=",15)) {
@@ -610,6 +953,12 @@ int main(int argc, char **argv)
             cfg.scale_mode = SCALE_FIT;
         } else if (!strcmp(argv[i],"--stretch")) {
             cfg.scale_mode = SCALE_STRETCH;
+        } else if (!strncmp(argv[i],"--scale-filter=",15)) {
+            cfg.scale_filter = parse_scale_filter(argv[i] + 15);
+        } else if (!strcmp(argv[i],"--tx-thread")) {
+            cfg.tx_thread = 1;
+        } else if (!strcmp(argv[i],"--no-tx-thread")) {
+            cfg.tx_thread = 0;
         } else if (!strcmp(argv[i],"--test")) {
             cfg.test_pattern = 1;
         }
@@ -629,7 +978,9 @@ int main(int argc, char **argv)
 #endif
         else if (!strcmp(argv[i],"-h")||!strcmp(argv[i],"--help")) {
             printf("Usage: fbcp [--config=PATH] [--src=DEV] [--spi=DEV] [--gpio=CHIP] [--fps=N] [--spi-speed=MHz] [--test]"
+                   "\n  [--idle-fps=N] [--idle-after=FRAMES]"
                    "\n  [--render-width=N] [--render-height=N] [--scale-mode=fit|stretch] [--fit] [--stretch]"
+                   "\n  [--scale-filter=nearest|box] [--tx-thread] [--no-tx-thread]"
 #ifdef ENABLE_TOUCH
                    "\n  [--touch] [--no-touch] [--touch-dev=DEV] [--touch-speed=HZ] [--touch-swap-xy]\n"
                    "  [--touch-invert-x] [--touch-invert-y] [--touch-no-swap-xy]\n"
@@ -680,10 +1031,11 @@ int main(int argc, char **argv)
     compute_content_rect(sw, sh, cfg.scale_mode, &content);
 
     fprintf(stderr,
-            "fbcp: cfg=%s src=%s %ux%u %ubpp → %dx%d @ %d FPS (spi=%u Hz, render=%ux%u, scale=%s, active=%ux%u+%u+%u)\n",
+            "fbcp: cfg=%s src=%s %ux%u %ubpp → %dx%d @ %d FPS (spi=%u Hz, render=%ux%u, scale=%s/%s, active=%ux%u+%u+%u)\n",
             cfg.config_path, cfg.src_dev, sw, sh, sbpp, DISPLAY_W, DISPLAY_H, cfg.fps,
             spi_speed, cfg.render_width, cfg.render_height,
             cfg.scale_mode == SCALE_STRETCH ? "stretch" : "fit",
+            cfg.scale_filter == SCALE_FILTER_BOX ? "box" : "nearest",
             content.w, content.h, content.x, content.y);
     if (cfg.render_width && cfg.render_height &&
         (cfg.render_width != sw || cfg.render_height != sh)) {
@@ -692,12 +1044,18 @@ int main(int argc, char **argv)
                 cfg.render_width, cfg.render_height, sw, sh);
     }
 
+    if (pacer_init(&g_pacer) < 0) {
+        fprintf(stderr, "fbcp: Cannot initialise frame pacer\n");
+        return 1;
+    }
+
     /* Start touch thread if requested */
 #ifdef ENABLE_TOUCH
     pthread_t touch_tid = 0;
     struct touch_args ta = { .spi_dev = cfg.touch_dev, .speed_hz = cfg.touch_speed_hz,
                              .width = DISPLAY_W, .height = DISPLAY_H,
                              .content = content, .running = &g_running,
+                             .pacer = &g_pacer,
                              .swap_xy = cfg.touch_swap_xy,
                              .invert_x = cfg.touch_invert_x,
                              .invert_y = cfg.touch_invert_y,
@@ -711,51 +1069,187 @@ int main(int argc, char **argv)
     }
 #endif
 
+    /*
+     * Two wire-order panel images: the frame loop converts into one while
+     * the tx thread may still be sending rows of the other, the image
+     * last queued.  `stale` marks rows where they differ.
+     */
     size_t npx = DISPLAY_W * DISPLAY_H;
-    uint16_t *dbuf = calloc(npx, 2);
-    long fns = 1000000000L / cfg.fps;
-    struct timespec next, t0;
-    clock_gettime(CLOCK_MONOTONIC, &next); t0 = next;
-    unsigned fc = 0;
+    uint16_t *img[2] = { image_alloc(npx), image_alloc(npx) };
+    int last = 1;                       /* img[last] was queued last */
+    uint8_t *stale = calloc(DISPLAY_H, 1);
+    uint8_t *prow = calloc(DISPLAY_H, 1);
+    struct damage_rect rects[DAMAGE_MAX_RECTS];
+    struct scaler sc = { 0 };
+    struct rowhash rh = { 0 };
+    uint8_t *dirty = calloc(DISPLAY_H, 1);
+    struct scaler_format sfmt = {
+        .bpp   = sbpp,
+        .r_off = ro, .r_len = src.v.red.length,
+        .g_off = go, .g_len = src.v.green.length,
+        .b_off = bo, .b_len = src.v.blue.length,
+    };
+    if (!img[0] || !img[1] || !stale || !prow || !dirty ||
+        rowhash_init(&rh, sh) < 0 ||
+        scaler_init(&sc, sw, sh, content.w, content.h, cfg.scale_filter) < 0) {
+        fprintf(stderr, "fbcp: Out of memory\n");
+        return 1;
+    }
+    tx_start(cfg.tx_thread);
+    fprintf(stderr, "fbcp: rectangles %s\n",
+            g_tx.active ? "sent by tx thread" : "sent inline");
+
+    struct timespec t0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    unsigned fc = 0, sent = 0;
+    int first = 1;
+    int damaged;
+    unsigned frame_end[2] = { 0, 0 };   /* tx_queued() after the last two frames */
+    unsigned dropped = 0;
+    unsigned rects_sent = 0;
+
+    /* Full rate while the source changes; idle_fps after idle_after quiet frames */
+    pacer_start(&g_pacer, cfg.fps, cfg.idle_fps, cfg.idle_after);
 
     while (g_running) {
-        if (content.w != DISPLAY_W || content.h != DISPLAY_H)
-            memset(dbuf, 0, npx * sizeof(*dbuf));
-
-        for (uint32_t dy = 0; dy < content.h; dy++) {
-            uint32_t sy = dy * sh / content.h;
-            uint16_t *dr = dbuf + (content.y + dy) * DISPLAY_W + content.x;
-            if (sbpp == 16) {
-                const uint16_t *sr = (const uint16_t*)(src.m + sy*sstr);
-                for (uint32_t dx = 0; dx < content.w; dx++) {
-                    uint16_t v = sr[dx*sw/content.w];
-                    dr[dx] = (v>>8)|(v<<8);
+        pacer_wait(&g_pacer);
+
+        /*
+         * Bus behind: the frame before the last one is still going out.
+         * Skip this tick without scanning, so its changes are picked up
+         * (merged with newer ones) on the next instead of queueing a
+         * frame that would be stale by the time it reached the panel.
+         */
+        if ((int)(frame_end[0] - tx_sent()) > 0) {
+            dropped++;
+            damaged = 1;
+            goto next_tick;
+        }
+
+        /* Unchanged source rows need neither scaling nor SPI traffic */
+        damaged = rowhash_scan(&rh, src.m, sstr, sw * (sbpp / 8)) != 0;
+        if (!damaged)
+            goto next_tick;
+        scaler_dirty_rows(&sc, rh.changed, dirty);
+        memcpy(prow + content.y, dirty, content.h);
+
+        /*
+         * img[last ^ 1] went out two frames ago (frame_end[0] says it has
+         * left the bus).  Rows about to be rescaled are overwritten; bring
+         * the other rows the last frame changed up to date.  Rows that
+         * keep changing every frame are never copied.
+         */
+        uint16_t *dbuf = img[last ^ 1], *prev = img[last];
+        for (uint32_t y = 0; y < DISPLAY_H; y++) {
+            if (stale[y] && !prow[y])
+                memcpy(dbuf + y * DISPLAY_W, prev + y * DISPLAY_W,
+                       DISPLAY_W * sizeof(*dbuf));
+            stale[y] = 0;
+        }
+
+        /*
+         * Convert and diff one band of DAMAGE_TILE rows at a time and
+         * queue its rectangles right away, so the bus sends band N while
+         * band N+1 is converted.  The first frame paints the whole panel,
+         * bars included; after that only cells of rescaled rows that
+         * differ from the last frame go out, with gaps bridged while the
+         * clean pixels cost less than a window.  A rectangle below the
+         * last one in its columns continues the same write.
+         */
+        int nrects = 0;
+        struct damage_rect open;
+        int have_open = 0;
+        for (uint32_t y0 = 0; y0 < DISPLAY_H; y0 += DAMAGE_TILE) {
+            uint32_t y1 = y0 + DAMAGE_TILE < DISPLAY_H ? y0 + DAMAGE_TILE : DISPLAY_H;
+
+            /* Letterbox bars stay black: both images were zeroed at startup */
+            for (uint32_t py = y0; py < y1; py++) {
+                uint32_t dy = py - content.y;
+                uint16_t *dr = dbuf + py * DISPLAY_W + content.x;
+                if (py < content.y || dy >= content.h || !dirty[dy])
+                    continue;
+                if (sc.row_dup[dy]) {
+                    memcpy(dr, dr - DISPLAY_W, content.w * sizeof(*dr));
+                    continue;
                 }
-            } else {
-                const uint32_t *sr = (const uint32_t*)(src.m + sy*sstr);
-                for (uint32_t dx = 0; dx < content.w; dx++) {
-                    uint16_t v = to565(sr[dx*sw/content.w], ro, go, bo);
-                    dr[dx] = (v>>8)|(v<<8);
+                if (sc.filter == SCALE_FILTER_BOX) {
+                    scaler_box_row(&sc, dy, src.m, sstr, &sfmt, dr);
+                    for (uint32_t dx = 0; dx < content.w; dx++)
+                        dr[dx] = (dr[dx]>>8)|(dr[dx]<<8);
+                    continue;
+                }
+                const uint8_t *srow = src.m + sc.ymap[dy] * sstr;
+                if (sbpp == 16) {
+                    const uint16_t *sr = (const uint16_t*)srow;
+                    for (uint32_t dx = 0; dx < content.w; dx++) {
+                        uint16_t v = sr[sc.xmap[dx]];
+                        dr[dx] = (v>>8)|(v<<8);
+                    }
+                } else {
+                    const uint32_t *sr = (const uint32_t*)srow;
+                    for (uint32_t dx = 0; dx < content.w; dx++) {
+                        uint16_t v = to565(sr[sc.xmap[dx]], ro, go, bo);
+                        dr[dx] = (v>>8)|(v<<8);
+                    }
                 }
             }
-        }
-        lcd_push(dbuf, npx);
 
+            int n;
+            if (first) {
+                rects[0] = (struct damage_rect){ 0, y0, DISPLAY_W, y1 - y0 };
+                n = 1;
+            } else {
+                n = damage_diff_band(dbuf, prev, DISPLAY_W, DISPLAY_H, y0,
+                                     DAMAGE_TILE, prow, WINDOW_COST_PX,
+                                     have_open ? &open : NULL,
+                                     rects, DAMAGE_MAX_RECTS);
+            }
+
+            /* The rectangles are sent in place; the images now differ there */
+            for (int i = 0; i < n; i++) {
+                const struct damage_rect *r = &rects[i];
+                tx_rect(dbuf, r->x, r->y, r->w, r->h);
+                memset(stale + r->y, 1, r->h);
+            }
+            have_open = n > 0;
+            if (have_open)
+                open = rects[n - 1];
+            nrects += n;
+        }
+        first = 0;
+        if (nrects == 0)
+            goto next_tick;
+
+        last ^= 1;
+        sent++;
+        rects_sent += (unsigned)nrects;
+        frame_end[0] = frame_end[1];
+        frame_end[1] = tx_queued();
+
+next_tick:
+        /* FPS counts frames queued to the panel, not pacer ticks */
         if (++fc % 100 == 0) {
             struct timespec now; clock_gettime(CLOCK_MONOTONIC, &now);
             double e = (now.tv_sec-t0.tv_sec)+(now.tv_nsec-t0.tv_nsec)/1e9;
-            if (e>0) fprintf(stderr, "fbcp: %.1f FPS (%u frames)\n", fc/e, fc);
+            if (e>0) fprintf(stderr, "fbcp: %.1f FPS (%u frames sent in %u ticks, %u rects, %u ticks skipped on a busy bus)\n",
+                             sent/e, sent, fc, rects_sent, dropped);
         }
-        next.tv_nsec += fns;
-        while (next.tv_nsec >= 1000000000L) { next.tv_nsec -= 1000000000L; next.tv_sec++; }
-        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        pacer_frame(&g_pacer, damaged);
     }
 
-    free(dbuf);
+    tx_stop();
+    scaler_free(&sc);
+    rowhash_free(&rh);
+    free(dirty);
+    free(prow);
+    free(stale);
+    free(img[0]);
+    free(img[1]);
 #ifdef ENABLE_TOUCH
     if (cfg.touch_enabled && touch_tid)
         pthread_join(touch_tid, NULL);
 #endif
+    pacer_destroy(&g_pacer);
     close(spi_fd); close(dc_fd); close(rst_fd);
     return 0;
 }
@@ -133,6 +133,7 @@ sed -i 's/^dtoverlay=vc4-fkms-v3d/dtoverlay=vc4-kms-v3d/' "$CONFIG"
 # Clean cmdline.txt
 sed -i 's/ fbcon=map:[^ ]*//g'           "$CMDLINE"
 sed -i 's/ video=HDMI-A-1:[^ ]*//g'      "$CMDLINE"
+sed -i 's/ spidev.bufsiz=[^ ]*//g'       "$CMDLINE"
 sed -i 's/  */ /g'              "$CMDLINE"
 sed -i 's/[[:space:]]*$//'      "$CMDLINE"
 